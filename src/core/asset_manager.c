@@ -1,4 +1,5 @@
 #include "asset_manager.h"
+#include "../game/scenes/sprite_batch.h"
 #include <raylib.h>
 
 Texture2D plantAtlas;
@@ -34,6 +35,8 @@ void assetManager_loadAssets() {
     cursorTexture_plant = LoadTexture("resources/assets/cursor_plant.png");
     cursorTexture_feed = LoadTexture("resources/assets/cursor_feed.png");
     cursorTexture_remove = LoadTexture("resources/assets/cursor_remove.png");
+
+    spriteBatch_load();
 }
 
 // If this is done when the game closes, is it really necesary?
@@ -49,4 +52,5 @@ void assetManager_unloadAssets() {
     UnloadTexture(cursorTexture_feed);
     UnloadTexture(cursorTexture_remove);
     UnloadTexture(slab1Texture);
+    spriteBatch_unload();
 }
@@ -1,9 +1,9 @@
 #include "../game/game.h"
+#include "../utils/jobs.h"
 #include "asset_manager.h"
 #include "raylib.h"
 
 #define TARGET_FPS 144
-#define MIN_FPS 30
 
 int main(void) {
     SetTargetFPS(TARGET_FPS);
@@ -15,6 +15,7 @@ int main(void) {
     SetExitKey(KEY_NULL);
 
     assetManager_loadAssets();
+    jobs_init(0);
 
     Game g;
     game_init(&g);
@@ -23,16 +24,9 @@ int main(void) {
      * MAIN LOOP
      */
     while (!WindowShouldClose()) {
+        // unclamped: game_update caps the ticks run per frame
         float deltaTime = GetFrameTime();
 
-        // Maximum 1/60th of a second (16.67ms) per frame for smooth movement
-        if (deltaTime > 1.0f / MIN_FPS) {
-            TraceLog(LOG_WARNING,
-                "Frame took %.2fms. Clamping to 16.67ms for smooth movement",
-                deltaTime * 1000.0f);
-            deltaTime = 1.0f / MIN_FPS;
-        }
-
         game_processInput(&g);
         game_update(&g, deltaTime);
         game_draw(&g);
@@ -40,6 +34,7 @@ int main(void) {
 
     // Should we?
     assetManager_unloadAssets();
+    jobs_shutdown();
 
     return 0;
 }
@@ -1,10 +1,13 @@
+#include "debug_panel.h"
 #include "../core/asset_manager.h"
 #include "../game/constants.h"
 #include "../game/scenes/scene.h"
 #include "../game/scenes/scene_data.h"
 #include "../input/input.h"
+#include "../ui/ui_text_run.h"
 #include "../utils/grid.h"
 #include "../utils/utils.h"
+#include <assert.h>
 #include <raylib.h>
 #include <stdio.h>
 
@@ -17,19 +20,26 @@ const int PANEL_H = 500;
 const int PANEL_FONT_SIZE = 32 * 2;
 const int PANEL_FONT_LINE_HEIGHT = PANEL_FONT_SIZE + 4;
 const int PANEL_MARGIN = 10;
+#define PANEL_LINES_COUNT 4
 
 static char buffer[64];
 
 int cursorX = 0;
 int cursorY = 0;
+// Laid out again only when their text changes
+UITextRun panelLines[PANEL_LINES_COUNT] = {0};
+int panelLine = 0;
 
 void cursorToNextLine() {
     cursorY += PANEL_FONT_SIZE + (PANEL_FONT_LINE_HEIGHT / 2);
 }
 
 void drawBufferAndMoveToNextLine() {
-    DrawTextEx(uiFont, buffer, (Vector2){cursorX, cursorY}, PANEL_FONT_SIZE, 1, PANEL_FONT_COLOR);
-    // DrawText(buffer, cursorX, cursorY, PANEL_FONT_SIZE, PANEL_FONT_COLOR);
+    assert(panelLine < PANEL_LINES_COUNT && "More panel lines than PANEL_LINES_COUNT");
+
+    UITextRun *line = &panelLines[panelLine++];
+    uiTextRun_set(line, uiFont, PANEL_FONT_SIZE, 1, buffer);
+    uiTextRun_draw(line, (Vector2){cursorX, cursorY}, PANEL_FONT_COLOR);
     cursorToNextLine();
 }
 
@@ -43,9 +53,19 @@ void writeMousePos() {
     snprintf(buffer, sizeof(buffer), "[ %.0f, %.0f ]", m->x, m->y);
 }
 
-void debugPanel_draw() {
+void writeGameplaySpeed(const Game *game) {
+    int multiplier = gameplay_getSpeedMultiplier(game->gameplaySpeed);
+    snprintf(buffer, sizeof(buffer), "Speed x%d", multiplier);
+}
+
+void writeInterceptBullets() {
+    snprintf(buffer, sizeof(buffer), "Intercept %s", gameplay_interceptBullets ? "on" : "off");
+}
+
+void debugPanel_draw(const Game *game) {
     cursorX = PANEL_X + PANEL_MARGIN;
     cursorY = PANEL_Y + PANEL_MARGIN + (PANEL_FONT_LINE_HEIGHT / 2);
+    panelLine = 0;
 
     DrawRectangle(PANEL_X, PANEL_Y, PANEL_W, PANEL_H, PANEL_BG_COLOR);
 
@@ -54,4 +74,10 @@ void debugPanel_draw() {
 
     writeHoveredTile();
     drawBufferAndMoveToNextLine();
+
+    writeGameplaySpeed(game);
+    drawBufferAndMoveToNextLine();
+
+    writeInterceptBullets();
+    drawBufferAndMoveToNextLine();
 }
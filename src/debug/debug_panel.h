@@ -1,3 +1,5 @@
 #pragma once
 
-void debugPanel_draw();
+#include "../game/game.h"
+
+void debugPanel_draw(const Game *game);
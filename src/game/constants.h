@@ -1,2 +1,5 @@
 #define TILE_WIDTH 32
 #define TILE_HEIGHT (int)(TILE_WIDTH / 2)
+
+// Of the game view, where there are no tiles
+#define SCENE_BACKGROUND_COLOR (Color){100, 100, 100, 100}
@@ -22,6 +22,7 @@ void calculateGameView(Game *game) {
 
 void game_init(Game *game) {
     game->gameplaySpeed = GAMEPLAY_SPEED_NORMAL;
+    game->tickAccumulator = 0;
 
     scene_init(1);
 
@@ -33,6 +34,14 @@ void game_processInput(Game *game) {
 
     scene_handleInput();
 
+    if (input.keyPressed == KEY_F) {
+        game->gameplaySpeed++;
+
+        if (game->gameplaySpeed == GAMEPLAY_SPEED_COUNT) {
+            game->gameplaySpeed = GAMEPLAY_SPEED_NORMAL;
+        }
+    }
+
     Message cmd = keyMap_processInput();
     if (messages_dispatchMessage(cmd, game)) {
         return;
@@ -45,18 +54,38 @@ void game_update(Game *game, float deltaTime) {
         calculateGameView(game);
     }
 
-    scene_update(deltaTime);
+    scene_update();
+
+    int speedMultiplier = gameplay_getSpeedMultiplier(game->gameplaySpeed);
+    int maxTicks = GAMEPLAY_MAX_TICKS_PER_FRAME * speedMultiplier;
+    int ticks = 0;
+
+    game->tickAccumulator += deltaTime * speedMultiplier;
+
+    while (game->tickAccumulator >= GAMEPLAY_TICK_SECONDS && ticks < maxTicks) {
+        scene_tick(GAMEPLAY_TICK_SECONDS);
+        game->tickAccumulator -= GAMEPLAY_TICK_SECONDS;
+        ticks++;
+    }
+
+    // over budget: drop the backlog instead of trying to catch up on the next frame
+    if (game->tickAccumulator >= GAMEPLAY_TICK_SECONDS) {
+        game->tickAccumulator = 0;
+    }
 }
 
 void game_draw(Game *game) {
     // Draw scene in target render texture
+    // layers cached in their own textures, before the target is bound
+    scene_prepareDraw(target.texture.width, target.texture.height);
+
     BeginTextureMode(target);
 
-    ClearBackground((Color){100, 100, 100, 100});
+    ClearBackground(SCENE_BACKGROUND_COLOR);
 
     scene_draw();
 
-    debugPanel_draw();
+    debugPanel_draw(game);
 
     EndTextureMode();
 
@@ -6,6 +6,8 @@
 typedef struct Game {
     float scale;
     GameplaySpeed gameplaySpeed;
+    // Unsimulated time, in seconds, carried to the next frame
+    float tickAccumulator;
 } Game;
 
 void game_init(Game *game);
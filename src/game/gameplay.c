@@ -1,3 +1,22 @@
+#include "gameplay.h"
+#include <assert.h>
 #include <stdbool.h>
 
 bool gameplay_drawInfo = false;
+bool gameplay_interceptBullets = false;
+
+int gameplay_getSpeedMultiplier(GameplaySpeed speed) {
+    switch (speed) {
+    case GAMEPLAY_SPEED_NORMAL:
+        return 1;
+    case GAMEPLAY_SPEED_FAST:
+        return 2;
+    case GAMEPLAY_SPEED_FASTEST:
+        return 3;
+    case GAMEPLAY_SPEED_COUNT:
+        break;
+    }
+
+    assert(false && "Unexpected GameplaySpeed enum value");
+    return 1;
+}
@@ -1,6 +1,16 @@
 #pragma once
 
 #include <stdbool.h>
+
+// Simulation runs at a fixed rate, independent of the render FPS
+#define GAMEPLAY_TICKS_PER_SECOND 60
+#define GAMEPLAY_TICK_SECONDS (1.0f / GAMEPLAY_TICKS_PER_SECOND)
+// Ticks allowed per frame at normal speed. Faster speeds get this budget times their multiplier.
+// Time over the budget is dropped, so a slow frame doesn't make the next one even slower
+#define GAMEPLAY_MAX_TICKS_PER_FRAME 4
+// Damage over time hits every mob at once, this many times per second
+#define GAMEPLAY_DOT_TICKS_PER_SECOND 4
+
 typedef enum {
     GAMEPLAY_SPEED_NORMAL,
     GAMEPLAY_SPEED_FAST,
@@ -15,3 +25,7 @@ typedef enum {
 } GameplayMode;
 
 extern bool gameplay_drawInfo;
+// Bullets work out when they hit as they're fired, instead of chasing their target every tick
+extern bool gameplay_interceptBullets;
+
+int gameplay_getSpeedMultiplier(GameplaySpeed speed);
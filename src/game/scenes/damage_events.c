@@ -0,0 +1,101 @@
+#include "./damage_events.h"
+#include "../../utils/jobs.h"
+#include "./wave_manager.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DAMAGE_EVENTS_INITIAL_CAPACITY 256
+
+typedef struct {
+    DamageEvent *events;
+    int count;
+    int capacity;
+} DamageEventBuffer;
+
+// One per worker, so pushing needs no locks
+DamageEventBuffer threadBuffers[JOBS_MAX_WORKERS];
+// All of them together, for sorting
+DamageEventBuffer mergedBuffer;
+
+static void ensureCapacity(DamageEventBuffer *buffer, int capacity) {
+    if (buffer->capacity >= capacity) {
+        return;
+    }
+
+    int newCapacity = buffer->capacity == 0 ? DAMAGE_EVENTS_INITIAL_CAPACITY : buffer->capacity;
+
+    while (newCapacity < capacity) {
+        newCapacity *= 2;
+    }
+
+    buffer->events = realloc(buffer->events, sizeof(DamageEvent) * newCapacity);
+    assert(buffer->events != NULL && "Out of memory for damage events");
+
+    buffer->capacity = newCapacity;
+}
+
+static int compareDamageEvents(const void *a, const void *b) {
+    const DamageEvent *eventA = a;
+    const DamageEvent *eventB = b;
+
+    if (eventA->source != eventB->source) {
+        return eventA->source < eventB->source ? -1 : 1;
+    }
+
+    return eventA->sequence - eventB->sequence;
+}
+
+void damageEvents_push(DamageEvent event) {
+    DamageEventBuffer *buffer = &threadBuffers[jobs_getWorkerIndex()];
+
+    ensureCapacity(buffer, buffer->count + 1);
+    buffer->events[buffer->count++] = event;
+}
+
+void damageEvents_apply() {
+    int totalCount = 0;
+
+    for (int i = 0; i < JOBS_MAX_WORKERS; i++) {
+        totalCount += threadBuffers[i].count;
+    }
+
+    if (totalCount == 0) {
+        return;
+    }
+
+    ensureCapacity(&mergedBuffer, totalCount);
+    mergedBuffer.count = 0;
+
+    for (int i = 0; i < JOBS_MAX_WORKERS; i++) {
+        DamageEventBuffer *buffer = &threadBuffers[i];
+
+        for (int j = 0; j < buffer->count; j++) {
+            mergedBuffer.events[mergedBuffer.count++] = buffer->events[j];
+        }
+
+        buffer->count = 0;
+    }
+
+    qsort(mergedBuffer.events, mergedBuffer.count, sizeof(DamageEvent), compareDamageEvents);
+
+    for (int i = 0; i < mergedBuffer.count; i++) {
+        const DamageEvent *event = &mergedBuffer.events[i];
+
+        wave_mob_takeDamage(event->mobIndex, event->damage);
+
+        if (event->modifier != NULL) {
+            wave_mob_addModifier(event->mobIndex, event->modifier);
+        }
+    }
+
+    mergedBuffer.count = 0;
+}
+
+void damageEvents_clear() {
+    for (int i = 0; i < JOBS_MAX_WORKERS; i++) {
+        threadBuffers[i].count = 0;
+    }
+
+    mergedBuffer.count = 0;
+}
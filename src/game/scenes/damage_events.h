@@ -0,0 +1,26 @@
+#pragma once
+
+#include "./scene_data.h"
+
+// Damage and modifiers for mobs, queued from parallel jobs and applied later on the main thread,
+// so jobs never change mobs that other jobs are reading. Each thread has its own buffer; they're
+// merged and sorted by (source, sequence) before applying, so the outcome (i.e. which of two hits
+// kills a mob) is the same every run, whatever the number of threads.
+typedef struct {
+    // what queued it, i.e. the bullet. Unique per source within a batch
+    int source;
+    // order among the events of the same source
+    int sequence;
+    int mobIndex;
+    int damage;
+    // NULL for none
+    const StatModifier *modifier;
+} DamageEvent;
+
+/// From any job thread
+void damageEvents_push(DamageEvent event);
+
+/// Applies every queued event in order and empties the buffers. Main thread, out of jobs
+void damageEvents_apply();
+
+void damageEvents_clear();
@@ -0,0 +1,146 @@
+#include "./draw_list.h"
+#include "../../utils/grid.h"
+#include "./scene_data.h"
+#include <assert.h>
+#include <math.h>
+#include <raymath.h>
+#include <stdlib.h>
+
+#define DRAW_LIST_INITIAL_CAPACITY 1024
+// Depth steps inside a tile, from its far corner to its near one
+#define DRAW_LIST_TILE_DEPTH_STEPS 16
+// The layer goes in the top bits of the key, the depth in the rest
+#define DRAW_LIST_LAYER_SHIFT 28
+// Bits sorted per pass
+#define DRAW_LIST_RADIX_BITS 8
+#define DRAW_LIST_RADIX_SIZE (1 << DRAW_LIST_RADIX_BITS)
+
+typedef struct {
+    Sprite sprite;
+    Vector2 center;
+    Vector2 radius;
+    Color color;
+} DrawItem;
+
+DrawItem *drawItems = NULL;
+// By item, and in the same order as drawItems until sorted
+unsigned *drawKeys = NULL;
+int *drawOrder = NULL;
+// Where each sort pass writes to, then swapped with the above
+unsigned *drawKeysScratch = NULL;
+int *drawOrderScratch = NULL;
+int drawItemsCount = 0;
+int drawItemsCapacity = 0;
+
+void growDrawList() {
+    int newCapacity
+        = drawItemsCapacity == 0 ? DRAW_LIST_INITIAL_CAPACITY : drawItemsCapacity * 2;
+
+    drawItems = realloc(drawItems, sizeof(DrawItem) * newCapacity);
+    drawKeys = realloc(drawKeys, sizeof(unsigned) * newCapacity);
+    drawOrder = realloc(drawOrder, sizeof(int) * newCapacity);
+    drawKeysScratch = realloc(drawKeysScratch, sizeof(unsigned) * newCapacity);
+    drawOrderScratch = realloc(drawOrderScratch, sizeof(int) * newCapacity);
+
+    assert(drawItems != NULL && drawKeys != NULL && drawOrder != NULL && drawKeysScratch != NULL
+           && drawOrderScratch != NULL && "Out of memory for the draw list");
+
+    drawItemsCapacity = newCapacity;
+}
+
+unsigned drawList_getDepth(Vector2 tileSpacePoint) {
+    int cols = SCENE_DATA->cols;
+    int rows = SCENE_DATA->rows;
+    int x = Clamp(floorf(tileSpacePoint.x), 0, cols - 1);
+    int y = Clamp(floorf(tileSpacePoint.y), 0, rows - 1);
+
+    // toward the viewer inside the tile, from -1 (far corner) to 1 (near corner)
+    float inTile = Clamp((tileSpacePoint.y - y) - (tileSpacePoint.x - x), -1, 1);
+    unsigned step = (inTile + 1) / 2 * (DRAW_LIST_TILE_DEPTH_STEPS - 1) + 0.5f;
+
+    return grid_getZIndex(x, y, cols, rows) * DRAW_LIST_TILE_DEPTH_STEPS + step;
+}
+
+void drawList_push(DrawLayer layer,
+    unsigned depth,
+    Sprite sprite,
+    Vector2 center,
+    Vector2 radius,
+    Color color) {
+    assert(depth < (1u << DRAW_LIST_LAYER_SHIFT) && "Draw depth overflows into the layer");
+
+    if (drawItemsCount == drawItemsCapacity) {
+        growDrawList();
+    }
+
+    int i = drawItemsCount++;
+    drawItems[i] = (DrawItem){sprite, center, radius, color};
+    drawKeys[i] = (unsigned)layer << DRAW_LIST_LAYER_SHIFT;
+
+    if (layer == DRAW_LAYER_ENTITIES) {
+        drawKeys[i] |= depth;
+    }
+
+    drawOrder[i] = i;
+}
+
+/// LSD radix sort of the keys, carrying the item indices along. O(n) per pass, and passes
+/// where every key has the same digit are skipped: most frames use few layers and only the
+/// low bits of the depth. Returns the indices in draw order
+const int *sortDrawList() {
+    unsigned *keys = drawKeys;
+    int *order = drawOrder;
+    unsigned *keysOut = drawKeysScratch;
+    int *orderOut = drawOrderScratch;
+
+    for (int shift = 0; shift < 32; shift += DRAW_LIST_RADIX_BITS) {
+        int offsets[DRAW_LIST_RADIX_SIZE] = {0};
+
+        for (int i = 0; i < drawItemsCount; i++) {
+            offsets[(keys[i] >> shift) & (DRAW_LIST_RADIX_SIZE - 1)]++;
+        }
+
+        // all in the same bucket: the pass wouldn't move anything
+        if (offsets[(keys[0] >> shift) & (DRAW_LIST_RADIX_SIZE - 1)] == drawItemsCount) {
+            continue;
+        }
+
+        int start = 0;
+        for (int digit = 0; digit < DRAW_LIST_RADIX_SIZE; digit++) {
+            int count = offsets[digit];
+            offsets[digit] = start;
+            start += count;
+        }
+
+        for (int i = 0; i < drawItemsCount; i++) {
+            int at = offsets[(keys[i] >> shift) & (DRAW_LIST_RADIX_SIZE - 1)]++;
+            keysOut[at] = keys[i];
+            orderOut[at] = order[i];
+        }
+
+        unsigned *swapKeys = keys;
+        keys = keysOut;
+        keysOut = swapKeys;
+
+        int *swapOrder = order;
+        order = orderOut;
+        orderOut = swapOrder;
+    }
+
+    return order;
+}
+
+void drawList_flush() {
+    if (drawItemsCount == 0) {
+        return;
+    }
+
+    const int *order = sortDrawList();
+
+    for (int i = 0; i < drawItemsCount; i++) {
+        const DrawItem *item = &drawItems[order[i]];
+        spriteBatch_draw(item->sprite, item->center, item->radius, item->color);
+    }
+
+    drawItemsCount = 0;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "./sprite_batch.h"
+#include <raylib.h>
+
+// Sprites of a frame, pushed in any order and drawn sorted by layer and then iso depth, so
+// what's nearer to the viewer covers what's behind it (a mob walking behind a tower is hidden
+// by it). Sorted with a radix sort on the integer keys, stable: same key, push order.
+// Only entities are sorted by depth, the other layers are drawn in push order.
+
+typedef enum {
+    // flat on the floor, under everything. Range indicators...
+    DRAW_LAYER_GROUND,
+    // towers, mobs, bullets, sorted by depth
+    DRAW_LAYER_ENTITIES,
+    // on top of everything. The tower to place...
+    DRAW_LAYER_OVERLAY,
+    DRAW_LAYER_COUNT,
+} DrawLayer;
+
+/// Iso depth of a point in tile space, growing toward the viewer. grid_getZIndex of its tile,
+/// refined with the position inside it. Clamped to the grid
+unsigned drawList_getDepth(Vector2 tileSpacePoint);
+
+/// As spriteBatch_draw, but drawn on drawList_flush. `depth` from drawList_getDepth, ignored out
+/// of DRAW_LAYER_ENTITIES
+void drawList_push(DrawLayer layer,
+    unsigned depth,
+    Sprite sprite,
+    Vector2 center,
+    Vector2 radius,
+    Color color);
+/// Draws everything pushed since the last flush, in order, and empties the list
+void drawList_flush();
@@ -0,0 +1,100 @@
+#include "./floor_layer.h"
+#include "../../core/asset_manager.h"
+#include "../../utils/grid.h"
+#include "../constants.h"
+#include "./scene_data.h"
+#include "./view_mamanger.h"
+#include <raylib.h>
+#include <raymath.h>
+#include <rlgl.h>
+#include <stdbool.h>
+
+RenderTexture2D floorTexture = {0};
+// What the texture was drawn with
+Transform2D floorTransform = {0};
+bool floorValid = false;
+
+void floorLayer_invalidate() {
+    floorValid = false;
+}
+
+/// Only the ones in sight
+void drawTiles() {
+    int yMin, yMax;
+    view_getVisibleRows(SCENE_DATA->rows, &yMin, &yMax);
+
+    for (int y = yMin; y <= yMax; y++) {
+        int xMin, xMax;
+        view_getVisibleColumns(y, SCENE_DATA->cols, &xMin, &xMax);
+
+        for (int x = xMin; x <= xMax; x++) {
+            IsoRec tile = grid_toIsoRec(SCENE_TRANSFORM, (V2i){x, y}, (V2i){1, 1});
+            int tileIndex = y * SCENE_DATA->cols + x;
+            Color tint = SCENE_DATA->tileFlags[tileIndex] & SCENE_TILE_BLOCKED ? GRAY : WHITE;
+
+            DrawTexturePro(slab1Texture,
+                (Rectangle){0, 0, slab1Texture.width, slab1Texture.height},
+                (Rectangle){
+                    tile.left.x,
+                    tile.top.y,
+                    TILE_WIDTH * SCENE_TRANSFORM->scale,
+                    TILE_HEIGHT * SCENE_TRANSFORM->scale,
+                },
+                (Vector2){0, 0},
+                0,
+                tint);
+        }
+    }
+}
+
+void drawPath() {
+    for (int indexEnd = 1; indexEnd < SCENE_DATA->pathWaypointsCount; indexEnd++) {
+        V2i waypointStart = SCENE_DATA->pathWaypoints[indexEnd - 1];
+        V2i waypointEnd = SCENE_DATA->pathWaypoints[indexEnd];
+
+        Vector2 start = grid_getTileCenter(SCENE_TRANSFORM, waypointStart.x, waypointStart.y);
+        Vector2 end = grid_getTileCenter(SCENE_TRANSFORM, waypointEnd.x, waypointEnd.y);
+
+        DrawLineEx(start, end, TILE_WIDTH, (Color){234, 227, 173, 100});
+    }
+}
+
+void floorLayer_update(int viewWidth, int viewHeight) {
+    bool resized = floorTexture.texture.width != viewWidth
+                   || floorTexture.texture.height != viewHeight;
+
+    if (floorValid && !resized && floorTransform.scale == SCENE_TRANSFORM->scale
+        && Vector2Equals(floorTransform.translation, SCENE_TRANSFORM->translation)) {
+        return;
+    }
+
+    if (resized) {
+        UnloadRenderTexture(floorTexture);
+        floorTexture = LoadRenderTexture(viewWidth, viewHeight);
+    }
+
+    BeginTextureMode(floorTexture);
+
+    // what would be under it otherwise, as it replaces the view when drawn
+    ClearBackground(SCENE_BACKGROUND_COLOR);
+    drawTiles();
+    // for debug. Eventually, path will have a different sprite
+    drawPath();
+
+    EndTextureMode();
+
+    floorTransform = *SCENE_TRANSFORM;
+    floorValid = true;
+}
+
+void floorLayer_draw() {
+    // copied as is, alpha included, instead of blended with what was in the view
+    rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM);
+
+    // render textures are upside down
+    Rectangle source = {0, 0, floorTexture.texture.width, -floorTexture.texture.height};
+    DrawTextureRec(floorTexture.texture, source, (Vector2){0, 0}, WHITE);
+
+    EndBlendMode();
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+// Tiles and path. They only change with the view or the scene, so they're drawn once into a
+// texture the size of the view, and every frame just copies it.
+
+/// The scene changed. Redrawn on the next floorLayer_update
+void floorLayer_invalidate();
+/// Redraws the layer if the view moved, zoomed or resized, or it was invalidated. Out of any
+/// texture mode: it has its own
+void floorLayer_update(int viewWidth, int viewHeight);
+void floorLayer_draw();
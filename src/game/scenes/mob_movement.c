@@ -0,0 +1,156 @@
+#include "./mob_movement.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MOB_MOVEMENT_AVX2
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define MOB_MOVEMENT_SSE2
+#endif
+
+// No FMA on purpose: every version rounds the same way, so the simulation doesn't depend on the
+// instruction set it was built for.
+
+void mobMovement_advanceScalar(float *distances, const float *speeds, float deltaTime, int count) {
+    for (int i = 0; i < count; i++) {
+        distances[i] += speeds[i] * deltaTime;
+    }
+}
+
+void mobMovement_interpolateScalar(Vector2 *positions,
+    const float *distances,
+    MobSegments segments,
+    int count) {
+    for (int i = 0; i < count; i++) {
+        float t = distances[i] - segments.start[i];
+
+        positions[i].x = segments.originX[i] + segments.directionX[i] * t;
+        positions[i].y = segments.originY[i] + segments.directionY[i] * t;
+    }
+}
+
+#if defined(MOB_MOVEMENT_AVX2)
+
+void mobMovement_advance(float *distances, const float *speeds, float deltaTime, int count) {
+    __m256 dt = _mm256_set1_ps(deltaTime);
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256 distance = _mm256_loadu_ps(distances + i);
+        __m256 speed = _mm256_loadu_ps(speeds + i);
+
+        _mm256_storeu_ps(distances + i, _mm256_add_ps(distance, _mm256_mul_ps(speed, dt)));
+    }
+
+    mobMovement_advanceScalar(distances + i, speeds + i, deltaTime, count - i);
+}
+
+void mobMovement_interpolate(Vector2 *positions,
+    const float *distances,
+    MobSegments segments,
+    int count) {
+    int i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256 t = _mm256_sub_ps(_mm256_loadu_ps(distances + i),
+            _mm256_loadu_ps(segments.start + i));
+
+        __m256 x = _mm256_add_ps(_mm256_loadu_ps(segments.originX + i),
+            _mm256_mul_ps(_mm256_loadu_ps(segments.directionX + i), t));
+        __m256 y = _mm256_add_ps(_mm256_loadu_ps(segments.originY + i),
+            _mm256_mul_ps(_mm256_loadu_ps(segments.directionY + i), t));
+
+        // back to Vector2s. unpack works per 128 bits lane: x0 y0 x1 y1 | x4 y4 x5 y5...
+        __m256 low = _mm256_unpacklo_ps(x, y);
+        // ...x2 y2 x3 y3 | x6 y6 x7 y7
+        __m256 high = _mm256_unpackhi_ps(x, y);
+
+        float *out = (float *)(positions + i);
+        _mm256_storeu_ps(out, _mm256_permute2f128_ps(low, high, 0x20));
+        _mm256_storeu_ps(out + 8, _mm256_permute2f128_ps(low, high, 0x31));
+    }
+
+    MobSegments rest = {
+        segments.start + i,
+        segments.originX + i,
+        segments.originY + i,
+        segments.directionX + i,
+        segments.directionY + i,
+    };
+
+    mobMovement_interpolateScalar(positions + i, distances + i, rest, count - i);
+}
+
+const char *mobMovement_getInstructionSet() {
+    return "AVX2";
+}
+
+#elif defined(MOB_MOVEMENT_SSE2)
+
+void mobMovement_advance(float *distances, const float *speeds, float deltaTime, int count) {
+    __m128 dt = _mm_set1_ps(deltaTime);
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 distance = _mm_loadu_ps(distances + i);
+        __m128 speed = _mm_loadu_ps(speeds + i);
+
+        _mm_storeu_ps(distances + i, _mm_add_ps(distance, _mm_mul_ps(speed, dt)));
+    }
+
+    mobMovement_advanceScalar(distances + i, speeds + i, deltaTime, count - i);
+}
+
+void mobMovement_interpolate(Vector2 *positions,
+    const float *distances,
+    MobSegments segments,
+    int count) {
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 t = _mm_sub_ps(_mm_loadu_ps(distances + i), _mm_loadu_ps(segments.start + i));
+
+        __m128 x = _mm_add_ps(_mm_loadu_ps(segments.originX + i),
+            _mm_mul_ps(_mm_loadu_ps(segments.directionX + i), t));
+        __m128 y = _mm_add_ps(_mm_loadu_ps(segments.originY + i),
+            _mm_mul_ps(_mm_loadu_ps(segments.directionY + i), t));
+
+        // back to Vector2s: x0 y0 x1 y1, x2 y2 x3 y3
+        float *out = (float *)(positions + i);
+        _mm_storeu_ps(out, _mm_unpacklo_ps(x, y));
+        _mm_storeu_ps(out + 4, _mm_unpackhi_ps(x, y));
+    }
+
+    MobSegments rest = {
+        segments.start + i,
+        segments.originX + i,
+        segments.originY + i,
+        segments.directionX + i,
+        segments.directionY + i,
+    };
+
+    mobMovement_interpolateScalar(positions + i, distances + i, rest, count - i);
+}
+
+const char *mobMovement_getInstructionSet() {
+    return "SSE2";
+}
+
+#else
+
+void mobMovement_advance(float *distances, const float *speeds, float deltaTime, int count) {
+    mobMovement_advanceScalar(distances, speeds, deltaTime, count);
+}
+
+void mobMovement_interpolate(Vector2 *positions,
+    const float *distances,
+    MobSegments segments,
+    int count) {
+    mobMovement_interpolateScalar(positions, distances, segments, count);
+}
+
+const char *mobMovement_getInstructionSet() {
+    return "scalar";
+}
+
+#endif
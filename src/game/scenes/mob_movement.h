@@ -0,0 +1,36 @@
+#pragma once
+
+#include <raylib.h>
+
+// Movement kernels over the packed mob arrays of wave_manager. A mob on a path segment is at
+// `origin + direction * (distance - segmentStart)`. With the segment cached per mob (refreshed
+// only when it passes a waypoint), moving every mob is the same few float ops, so they go 8 at a
+// time with AVX2 (-mavx2), 4 with SSE2 (any x86-64) and one by one anywhere else.
+
+/// Segment each mob is walking, by slot. `direction` is normalized
+typedef struct {
+    const float *start;
+    const float *originX;
+    const float *originY;
+    const float *directionX;
+    const float *directionY;
+} MobSegments;
+
+/// distances[i] += speeds[i] * deltaTime
+void mobMovement_advance(float *distances, const float *speeds, float deltaTime, int count);
+
+/// Writes the point of its segment where each mob is, given the distance it traveled
+void mobMovement_interpolate(Vector2 *positions,
+    const float *distances,
+    MobSegments segments,
+    int count);
+
+/// Plain C versions. The fallback of the functions above, also used by the benchmark
+void mobMovement_advanceScalar(float *distances, const float *speeds, float deltaTime, int count);
+void mobMovement_interpolateScalar(Vector2 *positions,
+    const float *distances,
+    MobSegments segments,
+    int count);
+
+/// "AVX2", "SSE2" or "scalar"
+const char *mobMovement_getInstructionSet();
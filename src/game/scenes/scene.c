@@ -4,7 +4,10 @@
 #include "../../utils/grid.h"
 #include "../constants.h"
 #include "../gameplay.h"
+#include "./draw_list.h"
+#include "./floor_layer.h"
 #include "./scene_data.h"
+#include "./scene_timers.h"
 #include "./towers_manager.h"
 #include "./view_mamanger.h"
 #include "./wave_manager.h"
@@ -27,8 +30,10 @@ void drawIsoRecLines(IsoRec isoRec, Color color) {
 void scene_init(int sceneIndex) {
     scene_data_load(sceneIndex);
 
+    sceneTimers_clear();
     towers_clear();
     wave_initData();
+    floorLayer_invalidate();
 }
 
 void scene_handleInput() {
@@ -46,6 +51,10 @@ void scene_handleInput() {
         gameplay_drawInfo = !gameplay_drawInfo;
     }
 
+    if (input.keyPressed == KEY_I) {
+        gameplay_interceptBullets = !gameplay_interceptBullets;
+    }
+
     // temporal
     if (input.keyPressed == KEY_F1) {
         scene_init(1);
@@ -57,35 +66,35 @@ void scene_handleInput() {
     towers_handleInput();
 }
 
-void scene_update(float deltaTime) {
+// Once per frame
+void scene_update() {
     view_update();
-    wave_update(deltaTime);
-    towers_update(deltaTime);
 }
 
-void scene_draw() {
-    // draw tiles
-    int tileCount = SCENE_DATA->cols * SCENE_DATA->rows;
+// Once per simulation tick. May run several times per frame, or none
+void scene_tick(float tickSeconds) {
+    sceneTimers_advance();
+    wave_update(tickSeconds);
+    towers_update(tickSeconds);
+}
 
-    for (int i = 0; i < tileCount; i++) {
-        V2i coords = grid_getCoordsFromTileIndex(SCENE_DATA->cols, i);
-        IsoRec tile = grid_toIsoRec(SCENE_TRANSFORM, coords, (V2i){1, 1});
+void scene_prepareDraw(int viewWidth, int viewHeight) {
+    view_setSize(viewWidth, viewHeight);
+    floorLayer_update(viewWidth, viewHeight);
+}
 
-        DrawTexturePro(slab1Texture,
-            (Rectangle){0, 0, slab1Texture.width, slab1Texture.height},
-            (Rectangle){
-                tile.left.x,
-                tile.top.y,
-                TILE_WIDTH * SCENE_TRANSFORM->scale,
-                TILE_HEIGHT * SCENE_TRANSFORM->scale,
-            },
-            (Vector2){0, 0},
-            0,
-            WHITE);
-    }
+void scene_draw() {
+    floorLayer_draw();
 
+    // sprites, layered by depth
     towers_draw();
     wave_draw();
+    drawList_flush();
+
+    if (gameplay_drawInfo) {
+        towers_drawInfo();
+        wave_drawInfo();
+    }
 
     // draw hovered indicator
     if (hoveredTileIndex != -1) {
@@ -4,5 +4,8 @@ extern const int *const scene_hoveredTileIndex;
 
 void scene_init(int sceneIndex);
 void scene_handleInput();
-void scene_update(float deltaTime);
+void scene_update();
+void scene_tick(float tickSeconds);
+/// Out of any texture mode, before scene_draw
+void scene_prepareDraw(int viewWidth, int viewHeight);
 void scene_draw();
@@ -1,11 +1,16 @@
 #include "./scene_data.h"
+#include "../../utils/arena.h"
+#include "../../utils/grid.h"
 #include "../../utils/utils.h"
 #include <assert.h>
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #define SCENE_DATA_FILE_DIR "resources/scenes_data"
 #define SCENE_DATA_MAX_FILE_PATH SCENE_DATA_NAME_MAX_LENGTH + sizeof(SCENE_DATA_FILE_DIR)
+#define SCENE_DATA_DEFAULT_SPAWN_COOLDOWN 0.4f
 
 SceneData data = {
     .name = "",
@@ -13,12 +18,23 @@ SceneData data = {
     .rows = 0,
     .pathWaypointsCount = 0,
     .pathWaypoints = {},
+    .pathWaypointsDistance = {},
+    .pathLength = 0,
     .wavesCount = 0,
     .waves = {},
+    .mobsCount = 0,
+    .tileFlags = NULL,
 };
 
 const SceneData *const SCENE_DATA = &data;
 
+// Everything sized by the scene (i.e. mob storage). Released when the next scene loads
+Arena sceneArena = {0};
+
+// From the scene file, until the grid is built
+V2i blockedTiles[SCENE_DATA_MAX_BLOCKED_TILES];
+int blockedTilesCount = 0;
+
 void parseSceneFile(const char *path) {
     FILE *f = fopen(path, "r");
     if (!f) {
@@ -30,8 +46,6 @@ void parseSceneFile(const char *path) {
     int lineNumber = 0;
     bool nameFound = false;
 
-    int totalMobsCount = 0;
-
     while (fgets(line, sizeof(line), f)) {
         lineNumber++;
 
@@ -43,7 +57,8 @@ void parseSceneFile(const char *path) {
             continue;
 
         if (!nameFound) {
-            strncpy(data.name, line, sizeof(data.name) - 1);
+            // truncated to the name size, always terminated
+            snprintf(data.name, sizeof(data.name), "%.*s", (int)sizeof(data.name) - 1, line);
             nameFound = true;
             continue;
         }
@@ -56,7 +71,7 @@ void parseSceneFile(const char *path) {
         } break;
 
         case 'P': { // Waypoint
-            assert(data.pathWaypointsCount <= SCENE_DATA_MAX_WAYPOINTS
+            assert(data.pathWaypointsCount < SCENE_DATA_MAX_WAYPOINTS
                    && "Scene data with too many waypoints");
 
             V2i *p = &data.pathWaypoints[data.pathWaypointsCount];
@@ -67,19 +82,37 @@ void parseSceneFile(const char *path) {
             data.pathWaypointsCount++;
         } break;
 
+        case 'B': { // Blocked tile
+            assert(blockedTilesCount < SCENE_DATA_MAX_BLOCKED_TILES
+                   && "Scene data with too many blocked tiles");
+
+            V2i *b = &blockedTiles[blockedTilesCount];
+            int scanResponse = sscanf(line, "B %d %d", &b->x, &b->y);
+
+            assert(scanResponse == 2 && "Line failed to be parsed. Missing values?");
+
+            blockedTilesCount++;
+        } break;
+
         case 'W': { // Wave
-            assert(data.wavesCount <= SCENE_DATA_MAX_WAVES && "Scene data with too many waves");
+            assert(data.wavesCount < SCENE_DATA_MAX_WAVES && "Scene data with too many waves");
 
             WaveData *w = &data.waves[data.wavesCount];
-            int scanResponse = sscanf(
-                line, "W %d %d %d", &w->startDelaySeconds, (int *)(&w->mobType), &w->mobsCount);
+            w->spawnCooldownSeconds = SCENE_DATA_DEFAULT_SPAWN_COOLDOWN;
 
-            assert(scanResponse == 3 && "Line failed to be parsed. Missing values?");
-            assert(w->mobType < MOB_TYPE_COUNT && "Invalid mob type");
+            // spawn cooldown is optional
+            int scanResponse = sscanf(line,
+                "W %d %d %d %f",
+                &w->startDelaySeconds,
+                (int *)(&w->mobType),
+                &w->mobsCount,
+                &w->spawnCooldownSeconds);
 
-            totalMobsCount += w->mobsCount;
+            assert(scanResponse >= 3 && "Line failed to be parsed. Missing values?");
+            assert(w->mobType < MOB_TYPE_COUNT && "Invalid mob type");
+            assert(w->spawnCooldownSeconds > 0 && "Invalid spawn cooldown");
 
-            assert(totalMobsCount <= SCENE_DATA_MAX_MOBS && "Scene data with too many mobs");
+            data.mobsCount += w->mobsCount;
 
             data.wavesCount++;
         } break;
@@ -92,13 +125,77 @@ void parseSceneFile(const char *path) {
     fclose(f);
 }
 
+void computePathDistances() {
+    assert(data.pathWaypointsCount >= 2 && "Scene data needs at least two waypoints");
+
+    data.pathWaypointsDistance[0] = 0;
+
+    for (int i = 1; i < data.pathWaypointsCount; i++) {
+        V2i start = data.pathWaypoints[i - 1];
+        V2i end = data.pathWaypoints[i];
+
+        float segmentLength = hypotf(end.x - start.x, end.y - start.y);
+
+        data.pathWaypointsDistance[i] = data.pathWaypointsDistance[i - 1] + segmentLength;
+    }
+
+    data.pathLength = data.pathWaypointsDistance[data.pathWaypointsCount - 1];
+}
+
+void setTileFlag(int x, int y, SceneTileFlag flag) {
+    int tileIndex = grid_getTileIndexFromCoords(data.cols, data.rows, x, y);
+
+    if (tileIndex != -1) {
+        data.tileFlags[tileIndex] |= flag;
+    }
+}
+
+/// Marks the tiles crossed by the path, the blocked ones, and the rest as buildable
+void buildTileFlags() {
+    int tileCount = data.cols * data.rows;
+
+    data.tileFlags = scene_data_alloc(sizeof(*data.tileFlags) * tileCount);
+
+    for (int i = 1; i < data.pathWaypointsCount; i++) {
+        V2i start = data.pathWaypoints[i - 1];
+        V2i end = data.pathWaypoints[i];
+
+        // one tile per step along the longest axis, so it works whatever the direction
+        int steps = MAX(abs(end.x - start.x), abs(end.y - start.y));
+
+        for (int step = 0; step <= steps; step++) {
+            float t = steps == 0 ? 0 : (float)step / steps;
+
+            setTileFlag(lroundf(start.x + (end.x - start.x) * t),
+                lroundf(start.y + (end.y - start.y) * t),
+                SCENE_TILE_PATH);
+        }
+    }
+
+    for (int i = 0; i < blockedTilesCount; i++) {
+        setTileFlag(blockedTiles[i].x, blockedTiles[i].y, SCENE_TILE_BLOCKED);
+    }
+
+    for (int i = 0; i < tileCount; i++) {
+        if (!(data.tileFlags[i] & (SCENE_TILE_PATH | SCENE_TILE_BLOCKED))) {
+            data.tileFlags[i] |= SCENE_TILE_BUILDABLE;
+        }
+    }
+}
+
 void scene_data_load(int sceneIndex) {
+    arena_release(&sceneArena);
+
     strncpy(data.name, "", sizeof(data.name));
 
     data.cols = 0;
     data.rows = 0;
     data.pathWaypointsCount = 0;
+    data.pathLength = 0;
     data.wavesCount = 0;
+    data.mobsCount = 0;
+    data.tileFlags = NULL;
+    blockedTilesCount = 0;
 
     for (int i = 0; i < SCENE_DATA_MAX_WAVES; i++) {
         data.waves[i] = (WaveData){.mobsCount = 0, .mobType = 0};
@@ -106,6 +203,7 @@ void scene_data_load(int sceneIndex) {
 
     for (int i = 0; i < SCENE_DATA_MAX_WAYPOINTS; i++) {
         data.pathWaypoints[i] = (V2i){0, 0};
+        data.pathWaypointsDistance[i] = 0;
     }
 
     char path[SCENE_DATA_MAX_FILE_PATH];
@@ -115,4 +213,17 @@ void scene_data_load(int sceneIndex) {
     printf("Loading scene data from \"%s\"\n", path);
 
     parseSceneFile(path);
+    computePathDistances();
+    buildTileFlags();
+}
+
+/// Zeroed memory that lasts until the next scene_data_load
+void *scene_data_alloc(size_t size) {
+    return arena_alloc(&sceneArena, size);
+}
+
+unsigned char scene_data_getTileFlags(int x, int y) {
+    int tileIndex = grid_getTileIndexFromCoords(data.cols, data.rows, x, y);
+
+    return tileIndex == -1 ? 0 : data.tileFlags[tileIndex];
 }
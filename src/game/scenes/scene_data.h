@@ -1,11 +1,12 @@
 #pragma once
 
 #include "../../utils/utils.h"
+#include <stddef.h>
 
-#define SCENE_DATA_MAX_MOBS 1024
 #define SCENE_DATA_MAX_MOB_STAT_MODS 8
 #define SCENE_DATA_MAX_WAYPOINTS 10
 #define SCENE_DATA_MAX_WAVES 10
+#define SCENE_DATA_MAX_BLOCKED_TILES 256
 
 #define SCENE_DATA_NAME_MAX_LENGTH 64
 
@@ -44,18 +45,38 @@ typedef struct {
     int startDelaySeconds;
     int mobsCount;
     MobType mobType;
+    float spawnCooldownSeconds;
 } WaveData;
 
+// Bits of SceneData.tileFlags
+typedef enum {
+    SCENE_TILE_PATH = 1 << 0,
+    // from the B lines of the scene file, nothing can go there
+    SCENE_TILE_BLOCKED = 1 << 1,
+    // neither path nor blocked. Says nothing about towers already there
+    SCENE_TILE_BUILDABLE = 1 << 2,
+} SceneTileFlag;
+
 typedef struct {
     char name[SCENE_DATA_NAME_MAX_LENGTH];
     int cols;
     int rows;
     int pathWaypointsCount;
     V2i pathWaypoints[SCENE_DATA_MAX_WAYPOINTS];
+    // Distance along the path, in tiles, from the first waypoint to each waypoint
+    float pathWaypointsDistance[SCENE_DATA_MAX_WAYPOINTS];
+    float pathLength;
     int wavesCount;
     WaveData waves[SCENE_DATA_MAX_WAVES];
+    // of all waves
+    int mobsCount;
+    // SceneTileFlag bits, by tile index
+    unsigned char *tileFlags;
 } SceneData;
 
 extern const SceneData *const SCENE_DATA;
 
 void scene_data_load(int sceneIndex);
+void *scene_data_alloc(size_t size);
+/// 0 for coords out of the grid
+unsigned char scene_data_getTileFlags(int x, int y);
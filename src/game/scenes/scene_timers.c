@@ -0,0 +1,181 @@
+#include "./scene_timers.h"
+#include "../gameplay.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// 4 levels of 256 slots cover the whole unsigned tick range. A level 0 slot is one tick, a level
+// 1 slot 256 ticks, and so on. Timers sit in the level their distance to the current tick fits
+// in, and move down a level when the current tick reaches the start of their slot
+#define SCENE_TIMERS_LEVELS 4
+#define SCENE_TIMERS_SLOT_BITS 8
+#define SCENE_TIMERS_SLOTS (1 << SCENE_TIMERS_SLOT_BITS)
+#define SCENE_TIMERS_SLOT_MASK (SCENE_TIMERS_SLOTS - 1)
+#define SCENE_TIMERS_INITIAL_CAPACITY 1024
+
+typedef struct {
+    SceneTimerEvent event;
+    unsigned int dueTick;
+    // next timer in the same slot, or in the free list. -1 ends both
+    int next;
+} SceneTimer;
+
+SceneTimer *timers = NULL;
+int timersCapacity = 0;
+int freeTimersHead = -1;
+int pendingTimersCount = 0;
+
+// first timer of each slot, -1 when empty
+int slotsHead[SCENE_TIMERS_LEVELS][SCENE_TIMERS_SLOTS];
+
+unsigned int currentTick = 0;
+
+SceneTimerHandler handlers[SCENE_TIMER_TYPE_COUNT] = {0};
+
+void growTimersPool() {
+    int oldCapacity = timersCapacity;
+    int newCapacity = oldCapacity == 0 ? SCENE_TIMERS_INITIAL_CAPACITY : oldCapacity * 2;
+
+    timers = realloc(timers, sizeof(SceneTimer) * newCapacity);
+    assert(timers != NULL && "Out of memory for scene timers");
+
+    // pushed in reverse so lower indices are used first
+    for (int i = newCapacity - 1; i >= oldCapacity; i--) {
+        timers[i].next = freeTimersHead;
+        freeTimersHead = i;
+    }
+
+    timersCapacity = newCapacity;
+
+    if (oldCapacity > 0) {
+        printf("Scene timers pool grown to %d timers\n", newCapacity);
+    }
+}
+
+/// Puts the timer in the slot of the lowest level whose range reaches its due tick
+void insertTimer(int timerIndex) {
+    unsigned int dueTick = timers[timerIndex].dueTick;
+    unsigned int ticksLeft = dueTick - currentTick;
+
+    int level = 0;
+
+    while (level < SCENE_TIMERS_LEVELS - 1
+           && ticksLeft >= 1u << (SCENE_TIMERS_SLOT_BITS * (level + 1))) {
+        level++;
+    }
+
+    int slot = (dueTick >> (SCENE_TIMERS_SLOT_BITS * level)) & SCENE_TIMERS_SLOT_MASK;
+
+    timers[timerIndex].next = slotsHead[level][slot];
+    slotsHead[level][slot] = timerIndex;
+}
+
+/// Re-inserts the timers of a slot, now that they're closer than the slot's level
+void cascade(int level, int slot) {
+    int timerIndex = slotsHead[level][slot];
+    slotsHead[level][slot] = -1;
+
+    while (timerIndex != -1) {
+        int next = timers[timerIndex].next;
+        insertTimer(timerIndex);
+        timerIndex = next;
+    }
+}
+
+void sceneTimers_clear() {
+    for (int level = 0; level < SCENE_TIMERS_LEVELS; level++) {
+        for (int slot = 0; slot < SCENE_TIMERS_SLOTS; slot++) {
+            slotsHead[level][slot] = -1;
+        }
+    }
+
+    freeTimersHead = -1;
+
+    for (int i = timersCapacity - 1; i >= 0; i--) {
+        timers[i].next = freeTimersHead;
+        freeTimersHead = i;
+    }
+
+    pendingTimersCount = 0;
+    currentTick = 0;
+}
+
+void sceneTimers_setHandler(SceneTimerType type, SceneTimerHandler handler) {
+    handlers[type] = handler;
+}
+
+void sceneTimers_schedule(float delaySeconds, SceneTimerEvent event) {
+    unsigned int delayTicks = lroundf(delaySeconds * GAMEPLAY_TICKS_PER_SECOND);
+
+    sceneTimers_scheduleAt(currentTick + delayTicks, event);
+}
+
+void sceneTimers_scheduleAt(unsigned int tick, SceneTimerEvent event) {
+    assert(event.type >= 0 && event.type < SCENE_TIMER_TYPE_COUNT && "Invalid scene timer type");
+
+    // the current tick already fired
+    if ((int)(tick - currentTick) <= 0) {
+        tick = currentTick + 1;
+    }
+
+    if (freeTimersHead == -1) {
+        growTimersPool();
+    }
+
+    int timerIndex = freeTimersHead;
+    freeTimersHead = timers[timerIndex].next;
+
+    timers[timerIndex].event = event;
+    timers[timerIndex].dueTick = tick;
+    insertTimer(timerIndex);
+
+    pendingTimersCount++;
+}
+
+void sceneTimers_advance() {
+    currentTick++;
+
+    // higher levels first: what they drop may land in the lower level slot that cascades now
+    int topLevel = 0;
+
+    while (topLevel < SCENE_TIMERS_LEVELS - 1
+           && (currentTick & ((1u << (SCENE_TIMERS_SLOT_BITS * (topLevel + 1))) - 1)) == 0) {
+        topLevel++;
+    }
+
+    for (int level = topLevel; level > 0; level--) {
+        cascade(level, (currentTick >> (SCENE_TIMERS_SLOT_BITS * level)) & SCENE_TIMERS_SLOT_MASK);
+    }
+
+    // detached first, so handlers can schedule (and grow the pool) while these fire
+    int slot = currentTick & SCENE_TIMERS_SLOT_MASK;
+    int timerIndex = slotsHead[0][slot];
+    slotsHead[0][slot] = -1;
+
+    while (timerIndex != -1) {
+        SceneTimer *timer = &timers[timerIndex];
+        int next = timer->next;
+        SceneTimerEvent event = timer->event;
+
+        assert(timer->dueTick == currentTick && "Scene timer fired at the wrong tick");
+
+        timer->next = freeTimersHead;
+        freeTimersHead = timerIndex;
+        pendingTimersCount--;
+
+        if (handlers[event.type] != NULL) {
+            handlers[event.type](event);
+        }
+
+        timerIndex = next;
+    }
+}
+
+unsigned int sceneTimers_getTick() {
+    return currentTick;
+}
+
+int sceneTimers_getPendingCount() {
+    return pendingTimersCount;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+// Scheduler for everything in the scene that happens at a given simulation tick (wave starts,
+// spawns, modifiers expiring...). It's a hierarchical timer wheel, so advancing a tick only
+// touches the timers that fire (and, once every 256 ticks, the ones that get closer), no matter
+// how many are pending.
+//
+// Timers can't be canceled. Owners put a generation in the event and ignore the ones that don't
+// match theirs anymore.
+
+typedef enum {
+    SCENE_TIMER_WAVE_START,
+    SCENE_TIMER_WAVE_SPAWN,
+    SCENE_TIMER_MODIFIER_EXPIRE,
+    SCENE_TIMER_DOT_TICK,
+    SCENE_TIMER_BULLET_HIT,
+    SCENE_TIMER_TYPE_COUNT,
+} SceneTimerType;
+
+typedef struct {
+    SceneTimerType type;
+    // what it's about, for the handler: wave index, mob index...
+    int target;
+    int data;
+    unsigned int generation;
+} SceneTimerEvent;
+
+typedef void (*SceneTimerHandler)(SceneTimerEvent event);
+
+/// Drops every pending timer and goes back to tick 0. Handlers are kept. Needed once before the
+/// first schedule
+void sceneTimers_clear();
+void sceneTimers_setHandler(SceneTimerType type, SceneTimerHandler handler);
+
+/// Fires `event` `delaySeconds` from now, rounded to ticks. At least one tick
+void sceneTimers_schedule(float delaySeconds, SceneTimerEvent event);
+/// Fires `event` at an absolute tick. The next one if it already passed
+void sceneTimers_scheduleAt(unsigned int tick, SceneTimerEvent event);
+
+/// Moves one simulation tick forward and calls the handlers of the timers due
+void sceneTimers_advance();
+
+unsigned int sceneTimers_getTick();
+int sceneTimers_getPendingCount();
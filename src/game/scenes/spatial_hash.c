@@ -0,0 +1,83 @@
+#include "./spatial_hash.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void ensureCapacity(SpatialHash *hash, int cellsCount, int itemsCount) {
+    // +1 for the end of the last cell
+    if (hash->cellsCapacity < cellsCount + 1) {
+        hash->cellsCapacity = cellsCount + 1;
+        hash->cellsStart = realloc(hash->cellsStart, sizeof(int) * hash->cellsCapacity);
+        assert(hash->cellsStart != NULL && "Out of memory for spatial hash cells");
+    }
+
+    if (hash->itemsCapacity < itemsCount) {
+        hash->itemsCapacity = itemsCount;
+        hash->items = realloc(hash->items, sizeof(int) * hash->itemsCapacity);
+        assert(hash->items != NULL && "Out of memory for spatial hash items");
+    }
+}
+
+void spatialHash_build(SpatialHash *hash,
+    int cellsCount,
+    const int *itemsCell,
+    const int *itemsValue,
+    int itemsCount) {
+    ensureCapacity(hash, cellsCount, itemsCount);
+
+    hash->cellsCount = cellsCount;
+    hash->itemsCount = 0;
+
+    int *cellsStart = hash->cellsStart;
+    memset(cellsStart, 0, sizeof(int) * (cellsCount + 1));
+
+    // count items per cell, shifted by one so the prefix sum leaves the start of each cell
+    for (int i = 0; i < itemsCount; i++) {
+        int cell = itemsCell[i];
+
+        if (cell < 0) {
+            continue;
+        }
+
+        assert(cell < cellsCount && "Spatial hash item out of bounds");
+        cellsStart[cell + 1]++;
+        hash->itemsCount++;
+    }
+
+    for (int c = 0; c < cellsCount; c++) {
+        cellsStart[c + 1] += cellsStart[c];
+    }
+
+    // fill, using cellsStart[c] as the cursor of c. Each ends up where c + 1 starts...
+    for (int i = 0; i < itemsCount; i++) {
+        int cell = itemsCell[i];
+
+        if (cell < 0) {
+            continue;
+        }
+
+        hash->items[cellsStart[cell]++] = itemsValue[i];
+    }
+
+    // ...so shift everything back one cell
+    for (int c = cellsCount; c > 0; c--) {
+        cellsStart[c] = cellsStart[c - 1];
+    }
+
+    cellsStart[0] = 0;
+}
+
+int spatialHash_getCellItems(const SpatialHash *hash, int cell, const int **items) {
+    assert(cell >= 0 && cell < hash->cellsCount && "Spatial hash cell out of bounds");
+
+    *items = &hash->items[hash->cellsStart[cell]];
+
+    return hash->cellsStart[cell + 1] - hash->cellsStart[cell];
+}
+
+void spatialHash_free(SpatialHash *hash) {
+    free(hash->cellsStart);
+    free(hash->items);
+
+    *hash = (SpatialHash){0};
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+// Uniform grid of buckets, one per scene tile. Items are plain ints (i.e. mob indices) and the
+// whole thing is rebuilt from scratch every tick with a counting sort, so there's nothing to keep
+// in sync when items move or die.
+typedef struct {
+    int cellsCount;
+    int itemsCount;
+    int cellsCapacity;
+    int itemsCapacity;
+    // cellsStart[c] .. cellsStart[c + 1] is the range of `items` that belongs to cell c
+    int *cellsStart;
+    int *items;
+} SpatialHash;
+
+/// Item i goes to cell `itemsCell[i]` (or nowhere, if -1) and is stored as `itemsValue[i]`
+void spatialHash_build(SpatialHash *hash,
+    int cellsCount,
+    const int *itemsCell,
+    const int *itemsValue,
+    int itemsCount);
+
+/// Returns how many items are in the cell and points `items` to them
+int spatialHash_getCellItems(const SpatialHash *hash, int cell, const int **items);
+
+void spatialHash_free(SpatialHash *hash);
@@ -0,0 +1,98 @@
+#include "./sprite_batch.h"
+#include <assert.h>
+#include <raylib.h>
+#include <rlgl.h>
+
+#define SPRITE_ATLAS_WIDTH 256
+#define SPRITE_ATLAS_HEIGHT 128
+// Width of the ring, from its outer edge, as a fraction of its radius
+#define SPRITE_RING_WIDTH 0.02f
+
+Texture2D spriteAtlas = {0};
+// In texels, inside the atlas
+Rectangle spriteSources[SPRITE_COUNT];
+
+void spriteBatch_load() {
+    // one cell per sprite, side by side. Sources are 1 texel in, so filtering doesn't bleed
+    // from the neighbours
+    const Rectangle cells[SPRITE_COUNT] = {
+        [SPRITE_SQUARE] = {0, 0, 16, 16},
+        [SPRITE_DISC] = {16, 0, 64, 64},
+        [SPRITE_RING] = {80, 0, 128, 128},
+    };
+
+    Image atlas = GenImageColor(SPRITE_ATLAS_WIDTH, SPRITE_ATLAS_HEIGHT, BLANK);
+
+    for (int i = 0; i < SPRITE_COUNT; i++) {
+        Rectangle cell = cells[i];
+        int centerX = cell.x + cell.width / 2;
+        int centerY = cell.y + cell.height / 2;
+        int radius = cell.width / 2 - 1;
+
+        switch ((Sprite)i) {
+        case SPRITE_SQUARE:
+            ImageDrawRectangle(&atlas, cell.x, cell.y, cell.width, cell.height, WHITE);
+            break;
+        case SPRITE_DISC:
+            ImageDrawCircle(&atlas, centerX, centerY, radius, WHITE);
+            break;
+        case SPRITE_RING:
+            ImageDrawCircle(&atlas, centerX, centerY, radius, WHITE);
+            // pixels are overwritten, not blended, so this leaves a hole
+            ImageDrawCircle(
+                &atlas, centerX, centerY, radius * (1 - SPRITE_RING_WIDTH), BLANK);
+            break;
+        case SPRITE_COUNT:
+            assert(false && "Unexpected SPRITE_COUNT enum value");
+            break;
+        }
+
+        spriteSources[i] = (Rectangle){cell.x + 1, cell.y + 1, cell.width - 2, cell.height - 2};
+    }
+
+    spriteAtlas = LoadTextureFromImage(atlas);
+    SetTextureFilter(spriteAtlas, TEXTURE_FILTER_BILINEAR);
+
+    UnloadImage(atlas);
+}
+
+void spriteBatch_unload() {
+    UnloadTexture(spriteAtlas);
+}
+
+void spriteBatch_draw(Sprite sprite, Vector2 center, Vector2 radius, Color color) {
+    Rectangle source = spriteSources[sprite];
+
+    float u0 = source.x / SPRITE_ATLAS_WIDTH;
+    float v0 = source.y / SPRITE_ATLAS_HEIGHT;
+    float u1 = (source.x + source.width) / SPRITE_ATLAS_WIDTH;
+    float v1 = (source.y + source.height) / SPRITE_ATLAS_HEIGHT;
+
+    float left = center.x - radius.x;
+    float top = center.y - radius.y;
+    float right = center.x + radius.x;
+    float bottom = center.y + radius.y;
+
+    // same texture and mode as the last quad: raylib just appends to the current batch
+    rlCheckRenderBatchLimit(4);
+    rlSetTexture(spriteAtlas.id);
+    rlBegin(RL_QUADS);
+
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    rlNormal3f(0, 0, 1);
+
+    rlTexCoord2f(u0, v0);
+    rlVertex2f(left, top);
+
+    rlTexCoord2f(u0, v1);
+    rlVertex2f(left, bottom);
+
+    rlTexCoord2f(u1, v1);
+    rlVertex2f(right, bottom);
+
+    rlTexCoord2f(u1, v0);
+    rlVertex2f(right, top);
+
+    rlEnd();
+    rlSetTexture(0);
+}
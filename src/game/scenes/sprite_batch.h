@@ -0,0 +1,23 @@
+#pragma once
+
+#include <raylib.h>
+
+// Entities (mobs, towers, bullets...) drawn as tinted quads from a single atlas, generated at
+// load. Consecutive quads share texture and mode, so raylib puts them all in the same vertex
+// buffer and sends it in one draw call, or a few if it fills up. Anything else drawn in between
+// (text, lines) splits the batch, so keep it out of the loops.
+
+typedef enum {
+    SPRITE_SQUARE,
+    SPRITE_DISC,
+    SPRITE_RING,
+    SPRITE_COUNT,
+} Sprite;
+
+/// Needs the window
+void spriteBatch_load();
+void spriteBatch_unload();
+
+/// White sprite tinted with `color`, centered on `center` and `radius` (horizontal, vertical)
+/// from it to the edges. In world pixels
+void spriteBatch_draw(Sprite sprite, Vector2 center, Vector2 radius, Color color);
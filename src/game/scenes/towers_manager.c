@@ -1,39 +1,58 @@
+#include "./towers_manager.h"
+#ifndef HEADLESS
+#include "../../core/asset_manager.h"
 #include "../../input/input.h"
+#include "../../ui/ui_text_run.h"
+#include "./draw_list.h"
+#include "./view_mamanger.h"
+#endif
 #include "../../utils/grid.h"
+#include "../../utils/jobs.h"
 #include "../../utils/utils.h"
 #include "../constants.h"
 #include "../gameplay.h"
+#include "./damage_events.h"
 #include "./scene_data.h"
-#include "./view_mamanger.h"
+#include "./scene_timers.h"
 #include "wave_manager.h"
+#include <assert.h>
 #include <math.h>
 #include <raylib.h>
 #include <raymath.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
 
-#define SCENE_MAX_TOWERS 20
-#define SCENE_MAX_BULLETS 1024
-
-static char buffer[16];
+// Tower groups and the bullet pool double when they run out of room
+#define SCENE_INITIAL_TOWERS_CAPACITY 16
+#define SCENE_INITIAL_BULLETS_CAPACITY 1024
+// Per job of the parallel passes. Target searches can be long, so towers go in small batches
+#define SCENE_TOWERS_PER_JOB 4
+#define SCENE_BULLETS_PER_JOB 1024
+#define SCENE_AOE_IMPACTS_PER_JOB 16
 
 GameplayMode gameplayMode = GAMEPLAY_MODE_NORMAL;
 
-typedef enum {
-    TOWER_TYPE_WHITE,
-    TOWER_TYPE_BLUE,
-    TOWER_TYPE_RED,
-    TOWER_TYPE_COUNT,
-} TowerType;
-
 typedef struct {
-    TowerType type;
-    bool onScene;
     V2i coords;
+    // Stretches of the path in range. Neither the tower nor the path move, so they're worked
+    // out once, when placed
+    PathInterval coverage[WAVE_MAX_PATH_INTERVALS];
+    int coverageCount;
+    TargetStrategy targetStrategy;
     int currentTargetMobIndex;
     float timeSinceLastShot;
+    // set by the targeting pass: the target was already there and still is in range
+    bool canShoot;
 } Tower;
 
+// The towers of one type, packed. Removing one moves the last one to its place
+typedef struct {
+    Tower *towers;
+    int count;
+    int capacity;
+} TowerGroup;
+
 typedef enum {
     BULLET_TYPE_SINGLE_TARGET,
     BULLET_TYPE_AOE,
@@ -60,31 +79,49 @@ const StatModifier dotModifier_1 = {
 const struct {
     // bullets per second
     float rateOfFile[TOWER_TYPE_COUNT];
+    // radius, in tiles
     float range[TOWER_TYPE_COUNT];
     int bulletDamage[TOWER_TYPE_COUNT];
-    int bulletAOE[TOWER_TYPE_COUNT];
+    // radius, in tiles
+    float bulletAOE[TOWER_TYPE_COUNT];
     Color bulletColor[TOWER_TYPE_COUNT];
     int bulletWidth[TOWER_TYPE_COUNT];
-    int bulletSpeed[TOWER_TYPE_COUNT];
+    // tiles per second
+    float bulletSpeed[TOWER_TYPE_COUNT];
     BulletTargetType bulletTargetType[TOWER_TYPE_COUNT];
     const StatModifier *bulletModifier[TOWER_TYPE_COUNT];
     Color color[TOWER_TYPE_COUNT];
 } towerTypeData = {
+    // distances were pixels at the initial zoom: tiles = px * sqrt(2) / (TILE_WIDTH * 5)
     .rateOfFile = {8, 1.2f, 0.8f},
-    .range = {320, 240, 280},
+    .range = {2.8f, 2.1f, 2.5f},
     .bulletDamage = {6, 8, 18},
-    .bulletAOE = {0, 40, 60},
+    .bulletAOE = {0, 0.35f, 0.53f},
     .bulletColor = {YELLOW, SKYBLUE, DARKBLUE},
     .bulletWidth = {4, 10, 16},
-    .bulletSpeed = {800, 500, 300},
+    .bulletSpeed = {7.07f, 4.42f, 2.65f},
     .bulletTargetType = {BULLET_TYPE_SINGLE_TARGET, BULLET_TYPE_AOE, BULLET_TYPE_AOE},
     .bulletModifier = {&dotModifier_1, &slowModifier_1, NULL},
     .color = {WHITE, BLUE, DARKPURPLE},
 };
 
-Tower towersPool[SCENE_MAX_TOWERS];
+// By type, so the type data stays the same along the loops over towers
+TowerGroup towerGroups[TOWER_TYPE_COUNT];
+// Tower on each tile, as `index * TOWER_TYPE_COUNT + type` (see getTowerOnTile), or -1 for none.
+// By tile index
+int *towersByTile = NULL;
 TowerType towerToPlaceType = TOWER_TYPE_WHITE;
 
+#ifndef HEADLESS
+const char *targetStrategyNames[TARGET_STRATEGY_COUNT] = {
+    "first",
+    "last",
+    "strongest",
+    "weakest",
+    "closest",
+};
+#endif
+
 typedef struct {
     bool alive;
     float travelProgress;
@@ -92,134 +129,444 @@ typedef struct {
     TowerType originTowerType;
     V2i originTowerCoords;
     int damage;
-    int AOE;
+    float AOE;
     BulletTargetType targetType;
     int mobTargetIndex;
     const StatModifier *modifier;
+    // Intercept bullets only (see gameplay_interceptBullets): they don't move, the hit is
+    // scheduled when fired and the position is worked out when drawn
+    bool intercept;
+    unsigned int fireTick;
+    unsigned int hitTick;
+    // position in interceptBullets
+    int listIndex;
+    // bumped every time the index is reused, for its scheduled hit
+    unsigned int generation;
 } TowerBullet;
 
-TowerBullet towerBullets[SCENE_MAX_BULLETS];
+// Bullet pool. Bullets keep their index while flying; free indices are kept in a stack, and the
+// flying ones in a packed list so updates and draws only visit those
+TowerBullet *towerBullets = NULL;
+int bulletsCapacity = 0;
+int *freeBullets = NULL;
+int freeBulletsCount = 0;
+int *activeBullets = NULL;
+int activeBulletsCount = 0;
+// Flying too, but nothing to update until they hit. Kept apart so updates don't visit them
+int *interceptBullets = NULL;
+int interceptBulletsCount = 0;
+
+// AOE impacts of the current tick, resolved together once every bullet moved
+typedef struct {
+    int mobIndex;
+    TowerType towerType;
+    // bullets of the same type that hit the same mob this tick
+    int hits;
+} AOEImpact;
+
+// At most one per active bullet, so it has the capacity of the bullet pool
+AOEImpact *aoeImpacts = NULL;
+int aoeImpactsCount = 0;
+
+void growBulletPool() {
+    int oldCapacity = bulletsCapacity;
+    int newCapacity = oldCapacity == 0 ? SCENE_INITIAL_BULLETS_CAPACITY : oldCapacity * 2;
+
+    towerBullets = realloc(towerBullets, sizeof(TowerBullet) * newCapacity);
+    freeBullets = realloc(freeBullets, sizeof(int) * newCapacity);
+    activeBullets = realloc(activeBullets, sizeof(int) * newCapacity);
+    interceptBullets = realloc(interceptBullets, sizeof(int) * newCapacity);
+    aoeImpacts = realloc(aoeImpacts, sizeof(AOEImpact) * newCapacity);
+
+    assert(towerBullets != NULL && freeBullets != NULL && activeBullets != NULL
+           && interceptBullets != NULL && aoeImpacts != NULL && "Out of memory for bullets");
+
+    // pushed in reverse so lower indices are used first
+    for (int i = newCapacity - 1; i >= oldCapacity; i--) {
+        towerBullets[i].alive = false;
+        towerBullets[i].generation = 0;
+        freeBullets[freeBulletsCount++] = i;
+    }
+
+    bulletsCapacity = newCapacity;
+
+    if (oldCapacity > 0) {
+        printf("Bullet pool grown to %d bullets\n", newCapacity);
+    }
+}
 
 void createBullet(TowerType towerType, int mobTargetIndex, int x, int y) {
-    for (int i = 0; i < SCENE_MAX_BULLETS; i++) {
-        if (!towerBullets[i].alive) {
-            towerBullets[i].alive = true;
-            towerBullets[i].travelProgress = 0;
-            towerBullets[i].originTowerType = towerType;
-            towerBullets[i].originTowerCoords.x = x;
-            towerBullets[i].originTowerCoords.y = y;
-            towerBullets[i].mobTargetIndex = mobTargetIndex;
-            towerBullets[i].position = grid_getTileCenter(SCENE_TRANSFORM, x, y);
-            towerBullets[i].damage = towerTypeData.bulletDamage[towerType];
-            towerBullets[i].targetType = towerTypeData.bulletTargetType[towerType];
-            towerBullets[i].AOE = towerTypeData.bulletAOE[towerType];
-            towerBullets[i].modifier = towerTypeData.bulletModifier[towerType];
-
-            printf("Created bullet from [%d, %d] to target enemy %d\n", x, y, mobTargetIndex);
-
-            return;
-        }
+    if (freeBulletsCount == 0) {
+        growBulletPool();
+    }
+
+    int i = freeBullets[--freeBulletsCount];
+
+    towerBullets[i].alive = true;
+    towerBullets[i].intercept = false;
+    towerBullets[i].generation++;
+    towerBullets[i].travelProgress = 0;
+    towerBullets[i].originTowerType = towerType;
+    towerBullets[i].originTowerCoords.x = x;
+    towerBullets[i].originTowerCoords.y = y;
+    towerBullets[i].mobTargetIndex = mobTargetIndex;
+    towerBullets[i].position = grid_getTileSpaceCenter(x, y);
+    towerBullets[i].damage = towerTypeData.bulletDamage[towerType];
+    towerBullets[i].targetType = towerTypeData.bulletTargetType[towerType];
+    towerBullets[i].AOE = towerTypeData.bulletAOE[towerType];
+    towerBullets[i].modifier = towerTypeData.bulletModifier[towerType];
+
+    float secondsToHit;
+
+    // homing, as a fallback, if the target would escape before the bullet reaches it
+    if (gameplay_interceptBullets
+        && wave_mob_getInterceptTime(mobTargetIndex,
+            towerBullets[i].position,
+            towerTypeData.bulletSpeed[towerType],
+            &secondsToHit)) {
+        towerBullets[i].intercept = true;
+        towerBullets[i].fireTick = sceneTimers_getTick();
+        towerBullets[i].hitTick
+            = towerBullets[i].fireTick + MAX(1, lroundf(secondsToHit * GAMEPLAY_TICKS_PER_SECOND));
+        towerBullets[i].listIndex = interceptBulletsCount;
+        interceptBullets[interceptBulletsCount++] = i;
+
+        SceneTimerEvent hit = {
+            .type = SCENE_TIMER_BULLET_HIT,
+            .target = i,
+            .generation = towerBullets[i].generation,
+        };
+
+        sceneTimers_scheduleAt(towerBullets[i].hitTick, hit);
+    } else {
+        activeBullets[activeBulletsCount++] = i;
     }
 }
 
-float getScaledTowerRange(float range) {
-    float scale = SCENE_TRANSFORM->scale / SCENE_SCALE_INITIAL;
+/// Returns the bullet at `activeIndex` of the active list to the pool. The last active bullet
+/// takes its place in the list
+void destroyBullet(int activeIndex) {
+    int i = activeBullets[activeIndex];
 
-    return range * scale;
+    towerBullets[i].alive = false;
+    freeBullets[freeBulletsCount++] = i;
+    activeBullets[activeIndex] = activeBullets[--activeBulletsCount];
 }
 
-bool isInRange(int mobIndex, Vector2 towerPos, float towerRange) {
-    float scaledRange = getScaledTowerRange(towerRange);
+void destroyInterceptBullet(int bulletIndex) {
+    int listIndex = towerBullets[bulletIndex].listIndex;
+    int lastBulletIndex = interceptBullets[--interceptBulletsCount];
+
+    interceptBullets[listIndex] = lastBulletIndex;
+    towerBullets[lastBulletIndex].listIndex = listIndex;
 
-    Vector2 mobPos = wave_mob_getPosition(mobIndex);
-    return utils_checkCollisionPointEllipse(mobPos, towerPos, scaledRange, scaledRange / 2);
+    towerBullets[bulletIndex].alive = false;
+    freeBullets[freeBulletsCount++] = bulletIndex;
 }
 
-/// Returns -1 if no mob found
-/// @param `maxDistanceSqrt` - the tower range squared, to be compared to the distance squared (to
-/// avoid square roots)
-int getTowerTarget(Vector2 towerPosition, float towerRange) {
-    int mobCount = wave_getMobCount();
+/// Queues the damage of an intercept bullet. Applied with the rest in updateBullets
+void onBulletHit(SceneTimerEvent event) {
+    TowerBullet *bullet = &towerBullets[event.target];
 
-    int mostTraveled = 0;
-    int targetIndex = -1;
+    if (!bullet->alive || bullet->generation != event.generation) {
+        return;
+    }
 
-    for (int i = 0; i < mobCount; i++) {
-        if (!wave_mob_isAlive(i)) {
-            continue;
+    DamageEvent hit = {
+        .source = event.target,
+        .sequence = 0,
+        .mobIndex = bullet->mobTargetIndex,
+        .damage = bullet->damage,
+        .modifier = bullet->modifier,
+    };
+
+    damageEvents_push(hit);
+
+    if (towerTypeData.bulletAOE[bullet->originTowerType] > 0) {
+        aoeImpacts[aoeImpactsCount++]
+            = (AOEImpact){bullet->mobTargetIndex, bullet->originTowerType, 1};
+    }
+
+    destroyInterceptBullet(event.target);
+}
+
+bool isCovered(const Tower *tower, float distance) {
+    for (int i = 0; i < tower->coverageCount; i++) {
+        if (tower->coverage[i].start <= distance && distance <= tower->coverage[i].end) {
+            return true;
         }
+    }
 
-        if (!isInRange(i, towerPosition, towerRange)) {
-            continue;
+    return false;
+}
+
+/// Range of tiles that can hold a point within `radius` of `center` (both in tile space)
+void getTilesInRadius(Vector2 center, float radius, V2i *tilesMin, V2i *tilesMax) {
+    tilesMin->x = MAX(0, (int)floorf(center.x - radius));
+    tilesMin->y = MAX(0, (int)floorf(center.y - radius));
+    tilesMax->x = MIN(SCENE_DATA->cols - 1, (int)floorf(center.x + radius));
+    tilesMax->y = MIN(SCENE_DATA->rows - 1, (int)floorf(center.y + radius));
+}
+
+/// The higher the better the target
+float getTargetScore(TargetStrategy strategy, Vector2 towerPosition, int mobIndex) {
+    switch (strategy) {
+    case TARGET_STRATEGY_FIRST:
+        return wave_mob_getDistanceTraveled(mobIndex);
+    case TARGET_STRATEGY_LAST:
+        return -wave_mob_getDistanceTraveled(mobIndex);
+    case TARGET_STRATEGY_STRONGEST:
+        return wave_mob_getHealth(mobIndex);
+    case TARGET_STRATEGY_WEAKEST:
+        return -wave_mob_getHealth(mobIndex);
+    case TARGET_STRATEGY_CLOSEST:
+    default:
+        return -Vector2DistanceSqr(towerPosition, wave_mob_getPosition(mobIndex));
+    }
+}
+
+/// First position in `distances` (sorted, the highest first) that is <= `distance`
+int findFirstAtOrBelow(const float *distances, int count, float distance) {
+    int low = 0;
+    int high = count;
+
+    while (low < high) {
+        int middle = (low + high) / 2;
+
+        if (distances[middle] <= distance) {
+            high = middle;
+        } else {
+            low = middle + 1;
         }
+    }
 
-        float traveled = wave_mob_getPercentajeTraveled(i);
+    return low;
+}
 
-        if (traveled > mostTraveled) {
-            mostTraveled = traveled;
-            targetIndex = i;
+/// First position in `distances` (sorted, the highest first) that is < `distance`
+int findFirstBelow(const float *distances, int count, float distance) {
+    int low = 0;
+    int high = count;
+
+    while (low < high) {
+        int middle = (low + high) / 2;
+
+        if (distances[middle] < distance) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+
+    return low;
+}
+
+/// Returns -1 if no mob found. Mobs are taken from the progress list, only from the stretches
+/// the tower covers, so they're all in range
+int getTowerTarget(const Tower *tower, Vector2 towerPosition) {
+    const int *mobIndices;
+    const float *distances;
+    int mobsCount = wave_getMobsByProgress(&mobIndices, &distances);
+
+    TargetStrategy strategy = tower->targetStrategy;
+    float bestScore = -INFINITY;
+    int targetIndex = -1;
+
+    for (int c = 0; c < tower->coverageCount; c++) {
+        // first looks from the end of the path, last from the start
+        int intervalIndex = strategy == TARGET_STRATEGY_FIRST ? tower->coverageCount - 1 - c : c;
+        const PathInterval *interval = &tower->coverage[intervalIndex];
+
+        // [from, to) are the mobs in the interval, the most traveled first
+        int from = findFirstAtOrBelow(distances, mobsCount, interval->end);
+        int to = findFirstBelow(distances, mobsCount, interval->start);
+
+        for (int j = from; j < to; j++) {
+            int i = strategy == TARGET_STRATEGY_LAST ? mobIndices[to - 1 - (j - from)]
+                                                     : mobIndices[j];
+
+            if (!wave_mob_isAlive(i)) {
+                continue;
+            }
+
+            // the rest of the intervals are worse
+            if (strategy == TARGET_STRATEGY_FIRST || strategy == TARGET_STRATEGY_LAST) {
+                return i;
+            }
+
+            float score = getTargetScore(strategy, towerPosition, i);
+
+            if (score > bestScore) {
+                bestScore = score;
+                targetIndex = i;
+            }
         }
     }
 
     return targetIndex;
 }
 
-void placeTower(int x, int y) {
-    if (wave_isPath(x, y)) {
-        return;
+bool towers_canPlace(int x, int y) {
+    if (!(scene_data_getTileFlags(x, y) & SCENE_TILE_BUILDABLE)) {
+        return false;
     }
 
-    int firstAvailableIndex = -1;
+    int tileIndex = grid_getTileIndexFromCoords(SCENE_DATA->cols, SCENE_DATA->rows, x, y);
 
-    for (int i = 0; i < SCENE_MAX_TOWERS; i++) {
-        if (firstAvailableIndex == -1 && !towersPool[i].onScene) {
-            firstAvailableIndex = i;
-            continue;
-        }
+    return towersByTile[tileIndex] == -1;
+}
 
-        if (towersPool[i].onScene && towersPool[i].coords.x == x && towersPool[i].coords.y == y) {
-            // space occupied by tower in position i
-            return;
-        }
+void setTowerOnTile(V2i coords, TowerType type, int index) {
+    int tileIndex
+        = grid_getTileIndexFromCoords(SCENE_DATA->cols, SCENE_DATA->rows, coords.x, coords.y);
+
+    towersByTile[tileIndex] = index == -1 ? -1 : index * TOWER_TYPE_COUNT + type;
+}
+
+/// Returns false if there's no tower there
+bool getTowerOnTile(int x, int y, TowerType *type, int *index) {
+    int tileIndex = grid_getTileIndexFromCoords(SCENE_DATA->cols, SCENE_DATA->rows, x, y);
+
+    if (tileIndex == -1 || towersByTile[tileIndex] == -1) {
+        return false;
     }
 
-    if (firstAvailableIndex != -1) {
-        Tower *tower = &towersPool[firstAvailableIndex];
-        tower->type = towerToPlaceType;
-        tower->onScene = true;
-        tower->coords.x = x;
-        tower->coords.y = y;
-        tower->currentTargetMobIndex = -1;
-        // will shoot as soon as it has a target
-        tower->timeSinceLastShot = 1.0f / towerTypeData.rateOfFile[towerToPlaceType];
+    *type = towersByTile[tileIndex] % TOWER_TYPE_COUNT;
+    *index = towersByTile[tileIndex] / TOWER_TYPE_COUNT;
 
-        gameplayMode = GAMEPLAY_MODE_NORMAL;
+    return true;
+}
+
+/// Returns false if the tile isn't buildable or already taken
+bool towers_place(TowerType type, int x, int y) {
+    if (!towers_canPlace(x, y)) {
+        return false;
+    }
+
+    TowerGroup *group = &towerGroups[type];
+
+    if (group->count == group->capacity) {
+        int newCapacity = group->capacity == 0 ? SCENE_INITIAL_TOWERS_CAPACITY
+                                               : group->capacity * 2;
+
+        group->towers = realloc(group->towers, sizeof(Tower) * newCapacity);
+        assert(group->towers != NULL && "Out of memory for towers");
+
+        group->capacity = newCapacity;
     }
 
-    // nothing happens if the tower is not set because there's no more space
+    int index = group->count++;
+
+    Tower *tower = &group->towers[index];
+    tower->coords.x = x;
+    tower->coords.y = y;
+    tower->targetStrategy = TARGET_STRATEGY_FIRST;
+    tower->currentTargetMobIndex = -1;
+    // will shoot as soon as it has a target
+    tower->timeSinceLastShot = 1.0f / towerTypeData.rateOfFile[type];
+    tower->canShoot = false;
+    tower->coverageCount = wave_getPathIntervalsInRange(
+        grid_getTileSpaceCenter(x, y), towerTypeData.range[type], tower->coverage);
+
+    setTowerOnTile(tower->coords, type, index);
+
+    return true;
+}
+
+/// Returns NULL if there's no tower there
+Tower *getTowerAt(int x, int y) {
+    TowerType type;
+    int index;
+
+    if (!getTowerOnTile(x, y, &type, &index)) {
+        return NULL;
+    }
+
+    return &towerGroups[type].towers[index];
+}
+
+bool towers_setTargetStrategy(int x, int y, TargetStrategy strategy) {
+    Tower *tower = getTowerAt(x, y);
+
+    if (tower == NULL) {
+        return false;
+    }
+
+    tower->targetStrategy = strategy;
+    // picked again with the new strategy
+    tower->currentTargetMobIndex = -1;
+
+    return true;
 }
 
 void removeTower(int x, int y) {
-    for (int i = 0; i < SCENE_MAX_TOWERS; i++) {
-        if (towersPool[i].coords.x == x && towersPool[i].coords.y == y) {
-            towersPool[i].onScene = false;
+    TowerType type;
+    int index;
 
-            return;
-        }
+    if (!getTowerOnTile(x, y, &type, &index)) {
+        return;
+    }
+
+    TowerGroup *group = &towerGroups[type];
+    int lastIndex = --group->count;
+
+    setTowerOnTile(group->towers[index].coords, type, -1);
+
+    if (index != lastIndex) {
+        group->towers[index] = group->towers[lastIndex];
+        setTowerOnTile(group->towers[index].coords, type, index);
     }
 }
 
 void towers_clear() {
     gameplayMode = GAMEPLAY_MODE_NORMAL;
 
-    for (int i = 0; i < SCENE_MAX_TOWERS; i++) {
-        towersPool[i].onScene = false;
-        towersPool[i].currentTargetMobIndex = -1;
-        towersPool[i].timeSinceLastShot = 0;
+    // capacity is kept for the next scene
+    for (int type = 0; type < TOWER_TYPE_COUNT; type++) {
+        towerGroups[type].count = 0;
+    }
+
+    // scene memory, so after the scene data loads
+    int tileCount = SCENE_DATA->cols * SCENE_DATA->rows;
+    towersByTile = scene_data_alloc(sizeof(*towersByTile) * tileCount);
+
+    for (int i = 0; i < tileCount; i++) {
+        towersByTile[i] = -1;
+    }
+
+    if (bulletsCapacity == 0) {
+        growBulletPool();
     }
 
-    for (int i = 0; i < SCENE_MAX_BULLETS; i++) {
+    activeBulletsCount = 0;
+    interceptBulletsCount = 0;
+    freeBulletsCount = 0;
+    aoeImpactsCount = 0;
+    damageEvents_clear();
+
+    sceneTimers_setHandler(SCENE_TIMER_BULLET_HIT, onBulletHit);
+
+    for (int i = bulletsCapacity - 1; i >= 0; i--) {
         towerBullets[i].alive = false;
+        freeBullets[freeBulletsCount++] = i;
+    }
+}
+
+#ifndef HEADLESS
+void cycleTargetStrategy(int x, int y) {
+    Tower *tower = getTowerAt(x, y);
+
+    if (tower == NULL) {
+        return;
+    }
+
+    // shown next to the tower by the info overlay
+    towers_setTargetStrategy(x, y, (tower->targetStrategy + 1) % TARGET_STRATEGY_COUNT);
+}
+
+void placeTower(int x, int y) {
+    if (towers_place(towerToPlaceType, x, y)) {
+        gameplayMode = GAMEPLAY_MODE_NORMAL;
     }
 }
 
@@ -231,7 +578,7 @@ void towers_handleInput() {
         if (grid_isValidCoords(SCENE_DATA->cols, SCENE_DATA->rows, coords.x, coords.y)) {
             switch (gameplayMode) {
             case GAMEPLAY_MODE_NORMAL:
-                // Select tower?
+                cycleTargetStrategy(coords.x, coords.y);
                 break;
             case GAMEPLAY_MODE_TOWER_REMOVE:
                 removeTower(coords.x, coords.y);
@@ -261,49 +608,62 @@ void towers_handleInput() {
         }
     }
 }
+#endif
 
-void updateTowers(float deltaTime) {
-    for (int i = 0; i < SCENE_MAX_TOWERS; i++) {
-        if (!towersPool[i].onScene) {
-            continue;
-        }
-
-        TowerType type = towersPool[i].type;
+/// Targeting pass, in parallel: only reads mobs and only writes the towers in [start, end) of
+/// the group in `context`
+void updateTowersTargetJob(void *context, int start, int end) {
+    TowerType type = *(const TowerType *)context;
+    Tower *towers = towerGroups[type].towers;
 
-        float towerSecondsPerBullet = 1.0f / towerTypeData.rateOfFile[type];
+    for (int i = start; i < end; i++) {
+        Tower *tower = &towers[i];
+        Vector2 towerPos = grid_getTileSpaceCenter(tower->coords.x, tower->coords.y);
+        int mobIndex = tower->currentTargetMobIndex;
 
-        Vector2 towerPos
-            = grid_getTileCenter(SCENE_TRANSFORM, towersPool[i].coords.x, towersPool[i].coords.y);
+        tower->canShoot = false;
 
-        if (towersPool[i].currentTargetMobIndex == -1) {
-            towersPool[i].currentTargetMobIndex
-                = getTowerTarget(towerPos, towerTypeData.range[type]);
+        if (mobIndex == -1 || !wave_mob_isAlive(mobIndex)) {
+            tower->currentTargetMobIndex = getTowerTarget(tower, towerPos);
             continue;
         }
 
-        int mobIndex = towersPool[i].currentTargetMobIndex;
-
-        if (!wave_mob_isAlive(mobIndex)) {
-            towersPool[i].currentTargetMobIndex
-                = getTowerTarget(towerPos, towerTypeData.range[type]);
+        if (!isCovered(tower, wave_mob_getDistanceTraveled(mobIndex))) {
+            tower->currentTargetMobIndex = -1;
             continue;
         }
 
-        if (!isInRange(mobIndex, towerPos, towerTypeData.range[type])) {
-            towersPool[i].currentTargetMobIndex = -1;
-            continue;
-        }
+        tower->canShoot = true;
+    }
+}
+
+void updateTowers(float deltaTime) {
+    for (TowerType type = 0; type < TOWER_TYPE_COUNT; type++) {
+        jobs_parallelFor(
+            towerGroups[type].count, SCENE_TOWERS_PER_JOB, updateTowersTargetJob, &type);
+    }
+
+    // shooting creates bullets, so in order on this thread
+    for (TowerType type = 0; type < TOWER_TYPE_COUNT; type++) {
+        Tower *towers = towerGroups[type].towers;
+        int count = towerGroups[type].count;
+        float towerSecondsPerBullet = 1.0f / towerTypeData.rateOfFile[type];
+
+        for (int i = 0; i < count; i++) {
+            Tower *tower = &towers[i];
 
-        towersPool[i].timeSinceLastShot += deltaTime;
+            if (!tower->canShoot) {
+                continue;
+            }
+
+            tower->timeSinceLastShot += deltaTime;
 
-        if (towersPool[i].timeSinceLastShot >= towerSecondsPerBullet) {
-            printf("Shooting after %0.2f seconds\n", towersPool[i].timeSinceLastShot);
-            towersPool[i].timeSinceLastShot -= towerSecondsPerBullet;
+            if (tower->timeSinceLastShot >= towerSecondsPerBullet) {
+                tower->timeSinceLastShot -= towerSecondsPerBullet;
 
-            createBullet(type,
-                towersPool[i].currentTargetMobIndex,
-                towersPool[i].coords.x,
-                towersPool[i].coords.y);
+                createBullet(
+                    type, tower->currentTargetMobIndex, tower->coords.x, tower->coords.y);
+            }
         }
     }
 }
@@ -311,14 +671,94 @@ void updateTowers(float deltaTime) {
 // --------
 // UPDATE -
 
-void updateBullets(float deltaTime) {
-    for (int bulletIndex = 0; bulletIndex < SCENE_MAX_BULLETS; bulletIndex++) {
-        if (!towerBullets[bulletIndex].alive) {
+int compareAOEImpacts(const void *a, const void *b) {
+    const AOEImpact *impactA = a;
+    const AOEImpact *impactB = b;
+
+    if (impactA->mobIndex != impactB->mobIndex) {
+        return impactA->mobIndex - impactB->mobIndex;
+    }
+
+    return impactA->towerType - impactB->towerType;
+}
+
+/// Splash queries, in parallel. Damage is queued, so every query sees the mobs as they were
+void splashAOEImpactsJob(void *context, int start, int end) {
+    for (int i = start; i < end; i++) {
+        const AOEImpact *impact = &aoeImpacts[i];
+
+        float aoe = towerTypeData.bulletAOE[impact->towerType];
+        float aoeSqrt = aoe * aoe;
+        int damage = towerTypeData.bulletDamage[impact->towerType] * impact->hits;
+        const StatModifier *modifier = towerTypeData.bulletModifier[impact->towerType];
+        Vector2 impactPos = wave_mob_getPosition(impact->mobIndex);
+        int sequence = 0;
+
+        V2i tilesMin, tilesMax;
+        getTilesInRadius(impactPos, aoe, &tilesMin, &tilesMax);
+
+        for (int y = tilesMin.y; y <= tilesMax.y; y++) {
+            for (int x = tilesMin.x; x <= tilesMax.x; x++) {
+                const int *mobIndices;
+                int mobsInTile = wave_getMobsInTile(x, y, &mobIndices);
+
+                for (int j = 0; j < mobsInTile; j++) {
+                    int otherMobIndex = mobIndices[j];
+
+                    if (otherMobIndex == impact->mobIndex) {
+                        continue;
+                    }
+
+                    if (!wave_mob_isAlive(otherMobIndex)) {
+                        continue;
+                    }
+
+                    float distanceSqrt
+                        = Vector2DistanceSqr(impactPos, wave_mob_getPosition(otherMobIndex));
+
+                    if (aoeSqrt >= distanceSqrt) {
+                        DamageEvent splash = {i, sequence++, otherMobIndex, damage, modifier};
+                        damageEvents_push(splash);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// Splash damage around the mob hit by the AOE bullets of this tick. Impacts of the same type on
+/// the same mob are merged, so they share a single query
+void resolveAOEImpacts() {
+    qsort(aoeImpacts, aoeImpactsCount, sizeof(AOEImpact), compareAOEImpacts);
+
+    int mergedCount = 0;
+
+    for (int i = 0; i < aoeImpactsCount; i++) {
+        AOEImpact *previous = mergedCount > 0 ? &aoeImpacts[mergedCount - 1] : NULL;
+
+        if (previous != NULL && compareAOEImpacts(previous, &aoeImpacts[i]) == 0) {
+            previous->hits++;
             continue;
         }
 
-        Vector2 originPos = grid_getTileCenter(SCENE_TRANSFORM,
-            towerBullets[bulletIndex].originTowerCoords.x,
+        aoeImpacts[mergedCount++] = aoeImpacts[i];
+    }
+
+    jobs_parallelFor(mergedCount, SCENE_AOE_IMPACTS_PER_JOB, splashAOEImpactsJob, NULL);
+    damageEvents_apply();
+
+    aoeImpactsCount = 0;
+}
+
+/// Travel pass, in parallel: only writes the bullets in [start, end) of the active list, and
+/// queues the damage of the ones that hit
+void moveBulletsJob(void *context, int start, int end) {
+    float deltaTime = *(const float *)context;
+
+    for (int activeIndex = start; activeIndex < end; activeIndex++) {
+        int bulletIndex = activeBullets[activeIndex];
+
+        Vector2 originPos = grid_getTileSpaceCenter(towerBullets[bulletIndex].originTowerCoords.x,
             towerBullets[bulletIndex].originTowerCoords.y);
 
         Vector2 targetPos = wave_mob_getPosition(towerBullets[bulletIndex].mobTargetIndex);
@@ -326,11 +766,9 @@ void updateBullets(float deltaTime) {
 
         TowerType towerType = towerBullets[bulletIndex].originTowerType;
         float bulletSpeed = towerTypeData.bulletSpeed[towerType];
-        float bulletDamage = towerTypeData.bulletDamage[towerType];
 
-        float scaledBulletSpeed = bulletSpeed * SCENE_TRANSFORM->scale / SCENE_SCALE_INITIAL;
         float distance = Vector2Distance(originPos, targetPos);
-        float dt = (scaledBulletSpeed * deltaTime) / distance;
+        float dt = (bulletSpeed * deltaTime) / distance;
 
         towerBullets[bulletIndex].travelProgress += dt;
         towerBullets[bulletIndex].travelProgress
@@ -339,46 +777,50 @@ void updateBullets(float deltaTime) {
         towerBullets[bulletIndex].position
             = Vector2Lerp(originPos, targetPos, towerBullets[bulletIndex].travelProgress);
 
-        if (towerBullets[bulletIndex].travelProgress != 1) {
-            continue;
+        if (towerBullets[bulletIndex].travelProgress == 1) {
+            DamageEvent hit = {
+                .source = activeIndex,
+                .sequence = 0,
+                .mobIndex = towerBullets[bulletIndex].mobTargetIndex,
+                .damage = towerBullets[bulletIndex].damage,
+                .modifier = towerBullets[bulletIndex].modifier,
+            };
+
+            damageEvents_push(hit);
         }
+    }
+}
 
-        int damagedMobIndex = towerBullets[bulletIndex].mobTargetIndex;
-        wave_mob_takeDamage(damagedMobIndex, bulletDamage);
-        towerBullets[bulletIndex].alive = false;
+void updateBullets(float deltaTime) {
+    // hits of intercept bullets, queued as the scene timers advanced
+    damageEvents_apply();
 
-        if (towerBullets[bulletIndex].modifier != NULL) {
-            wave_mob_addModifier(damagedMobIndex, towerBullets[bulletIndex].modifier);
-        }
+    jobs_parallelFor(activeBulletsCount, SCENE_BULLETS_PER_JOB, moveBulletsJob, &deltaTime);
+    damageEvents_apply();
 
-        // check aoe
-        if (towerTypeData.bulletAOE[towerType] > 0) {
-            float aoeSqrt = pow(towerTypeData.bulletAOE[towerType], 2);
-            int mobCount = wave_getMobCount();
+    // the active list changes, so in order on this thread
+    int activeIndex = 0;
 
-            // @performance: optimization oportunity
-            for (int otherMobIndex = 0; otherMobIndex < mobCount; otherMobIndex++) {
-                if (otherMobIndex == damagedMobIndex) {
-                    continue;
-                }
+    while (activeIndex < activeBulletsCount) {
+        int bulletIndex = activeBullets[activeIndex];
 
-                if (!wave_mob_isAlive(otherMobIndex)) {
-                    continue;
-                }
+        if (towerBullets[bulletIndex].travelProgress != 1) {
+            activeIndex++;
+            continue;
+        }
 
-                float distanceSqrt = Vector2DistanceSqr(
-                    wave_mob_getPosition(damagedMobIndex), wave_mob_getPosition(otherMobIndex));
+        TowerType towerType = towerBullets[bulletIndex].originTowerType;
+        int damagedMobIndex = towerBullets[bulletIndex].mobTargetIndex;
 
-                if (aoeSqrt >= distanceSqrt) {
-                    wave_mob_takeDamage(otherMobIndex, bulletDamage);
+        // the last active bullet is moved here, so activeIndex stays
+        destroyBullet(activeIndex);
 
-                    if (towerBullets[bulletIndex].modifier != NULL) {
-                        wave_mob_addModifier(otherMobIndex, towerBullets[bulletIndex].modifier);
-                    }
-                }
-            }
+        if (towerTypeData.bulletAOE[towerType] > 0) {
+            aoeImpacts[aoeImpactsCount++] = (AOEImpact){damagedMobIndex, towerType, 1};
         }
     }
+
+    resolveAOEImpacts();
 }
 
 void towers_update(float deltaTime) {
@@ -386,101 +828,174 @@ void towers_update(float deltaTime) {
     updateBullets(deltaTime);
 }
 
+#ifndef HEADLESS
 // ------
 // DRAW -
 
-void drawTower(TowerType type, Vector2 towerCenter) {
-    int towerWidth = 16;
-    int towerHeight = 8;
+// Ellipse radii, in pixels
+const Vector2 towerDrawRadius = {16, 8};
 
-    Color c = towerTypeData.color[type];
+void drawTower(TowerType type, V2i coords, DrawLayer layer) {
+    Vector2 towerCenter = grid_getTileCenter(SCENE_TRANSFORM, coords.x, coords.y);
 
-    DrawEllipse(towerCenter.x, towerCenter.y, towerWidth, towerHeight, c);
+    if (!view_isVisible(towerCenter, towerDrawRadius.x)) {
+        return;
+    }
 
+    unsigned depth = drawList_getDepth(grid_getTileSpaceCenter(coords.x, coords.y));
+    drawList_push(
+        layer, depth, SPRITE_DISC, towerCenter, towerDrawRadius, towerTypeData.color[type]);
+
+    // same key, so right on top of it
     if (gameplayMode == GAMEPLAY_MODE_TOWER_REMOVE) {
-        c = (Color){204, 67, 57, 100};
-        DrawEllipse(towerCenter.x, towerCenter.y, towerWidth, towerHeight, c);
+        drawList_push(
+            layer, depth, SPRITE_DISC, towerCenter, towerDrawRadius, (Color){204, 67, 57, 100});
     }
 }
 
-void drawRangeIndicator(float range, int towerX, int towerY) {
-    float scaledTowerRange = getScaledTowerRange(range);
+void drawRangeIndicator(float range, int towerX, int towerY, DrawLayer layer) {
+    float scaledTowerRange = grid_tileSpaceToWorldRadius(SCENE_TRANSFORM, range);
     Vector2 rangeIndicatorCenter = grid_getTileCenter(SCENE_TRANSFORM, towerX, towerY);
 
-    DrawEllipse(rangeIndicatorCenter.x,
-        rangeIndicatorCenter.y,
-        scaledTowerRange,
-        scaledTowerRange / 2,
-        (Color){100, 255, 100, 10});
+    Vector2 radius = {scaledTowerRange, scaledTowerRange / 2};
 
-    for (int j = 0; j < 3; j++) {
-        DrawEllipseLines(rangeIndicatorCenter.x,
-            rangeIndicatorCenter.y,
-            scaledTowerRange - j,
-            (scaledTowerRange - j) / 2,
-            (Color){40, 90, 40, 60});
+    if (!view_isVisible(rangeIndicatorCenter, radius.x)) {
+        return;
     }
+
+    drawList_push(
+        layer, 0, SPRITE_DISC, rangeIndicatorCenter, radius, (Color){100, 255, 100, 10});
+    drawList_push(layer, 0, SPRITE_RING, rangeIndicatorCenter, radius, (Color){40, 90, 40, 60});
 }
 
+/// Over everything else, as it follows the mouse
 void drawTowerToPlace() {
     // TODO: change
     Vector2 m = input.worldMousePos;
     V2i coords = grid_worldPointToCoords(SCENE_TRANSFORM, m.x, m.y);
     if (grid_isValidCoords(SCENE_DATA->cols, SCENE_DATA->rows, coords.x, coords.y)) {
         Vector2 tileCenter = grid_getTileCenter(SCENE_TRANSFORM, coords.x, coords.y);
-        drawTower(towerToPlaceType, tileCenter);
-        drawRangeIndicator(towerTypeData.range[towerToPlaceType], coords.x, coords.y);
+        drawTower(towerToPlaceType, coords, DRAW_LAYER_OVERLAY);
+
+        if (!towers_canPlace(coords.x, coords.y)) {
+            drawList_push(DRAW_LAYER_OVERLAY,
+                0,
+                SPRITE_DISC,
+                tileCenter,
+                towerDrawRadius,
+                (Color){204, 67, 57, 160});
+        }
+
+        drawRangeIndicator(
+            towerTypeData.range[towerToPlaceType], coords.x, coords.y, DRAW_LAYER_OVERLAY);
     }
 }
 
 void drawTowerRayToTarget(Vector2 towerPos, int mobIndex) {
-    Vector2 mobPos = wave_mob_getPosition(mobIndex);
+    Vector2 mobPos = grid_tileSpaceToWorldPoint(SCENE_TRANSFORM, wave_mob_getPosition(mobIndex));
     DrawLine(towerPos.x, towerPos.y, mobPos.x, mobPos.y, YELLOW);
 }
 
-void drawTowerTarget(Vector2 tileCenter, int mobIndex) {
-    snprintf(buffer, sizeof(buffer), "%d", mobIndex);
-    DrawText(buffer, tileCenter.x - 8, tileCenter.y - 30, 16, BLACK);
+// Set on every towers_drawInfo, but only laid out the first time
+UITextRun targetDigits = {0};
+UITextRun targetStrategyRuns[TARGET_STRATEGY_COUNT] = {0};
+
+/// Index of the target and strategy, as "12 FIRST"
+void drawTowerTarget(Vector2 tileCenter, int mobIndex, TargetStrategy strategy) {
+    Vector2 position = {tileCenter.x - 8, tileCenter.y - 30};
+    position.x += uiTextRun_drawNumber(&targetDigits, mobIndex, position, BLACK);
+    // a space
+    position.x += 4;
+    uiTextRun_draw(&targetStrategyRuns[strategy], position, BLACK);
 }
 
 void drawBullet(const TowerBullet *bullet) {
-    DrawCircle(bullet->position.x,
-        bullet->position.y,
-        towerTypeData.bulletWidth[bullet->originTowerType],
+    Vector2 position = bullet->position;
+
+    if (bullet->intercept) {
+        Vector2 originPos
+            = grid_getTileSpaceCenter(bullet->originTowerCoords.x, bullet->originTowerCoords.y);
+        float progress = (float)(sceneTimers_getTick() - bullet->fireTick)
+                         / (bullet->hitTick - bullet->fireTick);
+
+        position = Vector2Lerp(
+            originPos, wave_mob_getPosition(bullet->mobTargetIndex), Clamp(progress, 0, 1));
+    }
+
+    Vector2 bulletPos = grid_tileSpaceToWorldPoint(SCENE_TRANSFORM, position);
+
+    float radius = towerTypeData.bulletWidth[bullet->originTowerType];
+
+    if (!view_isVisible(bulletPos, radius)) {
+        return;
+    }
+
+    drawList_push(DRAW_LAYER_ENTITIES,
+        drawList_getDepth(position),
+        SPRITE_DISC,
+        bulletPos,
+        (Vector2){radius, radius},
         towerTypeData.bulletColor[bullet->originTowerType]);
 }
 
-void towers_draw() {
-    for (int i = 0; i < SCENE_MAX_TOWERS; i++) {
-        if (!towersPool[i].onScene) {
-            continue;
-        }
-
-        V2i towerCoords = towersPool[i].coords;
-        Vector2 tileCenter = grid_getTileCenter(SCENE_TRANSFORM, towerCoords.x, towerCoords.y);
-        TowerType type = towersPool[i].type;
-        drawTower(type, tileCenter);
+void towers_drawInfo() {
+    uiTextRun_set(&targetDigits, uiFont, 16, 1, UI_TEXT_RUN_DIGITS);
+    for (TargetStrategy strategy = 0; strategy < TARGET_STRATEGY_COUNT; strategy++) {
+        uiTextRun_set(&targetStrategyRuns[strategy], uiFont, 16, 1, targetStrategyNames[strategy]);
+    }
 
-        if (gameplay_drawInfo) {
-            int mobIndex = towersPool[i].currentTargetMobIndex;
-            drawRangeIndicator(towerTypeData.range[type], towerCoords.x, towerCoords.y);
-            drawTowerTarget(tileCenter, mobIndex);
+    // rays first and then all the text, so the text goes in a single batch
+    for (TowerType type = 0; type < TOWER_TYPE_COUNT; type++) {
+        for (int i = 0; i < towerGroups[type].count; i++) {
+            const Tower *tower = &towerGroups[type].towers[i];
+            int mobIndex = tower->currentTargetMobIndex;
 
+            // the ray may cross the view from outside, so it isn't culled
             if (wave_mob_isAlive(mobIndex)) {
+                Vector2 tileCenter
+                    = grid_getTileCenter(SCENE_TRANSFORM, tower->coords.x, tower->coords.y);
                 drawTowerRayToTarget(tileCenter, mobIndex);
             }
         }
     }
 
+    for (TowerType type = 0; type < TOWER_TYPE_COUNT; type++) {
+        for (int i = 0; i < towerGroups[type].count; i++) {
+            const Tower *tower = &towerGroups[type].towers[i];
+            Vector2 tileCenter
+                = grid_getTileCenter(SCENE_TRANSFORM, tower->coords.x, tower->coords.y);
+
+            // the text goes above it
+            if (view_isVisible(tileCenter, 60)) {
+                drawTowerTarget(tileCenter, tower->currentTargetMobIndex, tower->targetStrategy);
+            }
+        }
+    }
+}
+
+void towers_draw() {
+    for (TowerType type = 0; type < TOWER_TYPE_COUNT; type++) {
+        for (int i = 0; i < towerGroups[type].count; i++) {
+            V2i towerCoords = towerGroups[type].towers[i].coords;
+            drawTower(type, towerCoords, DRAW_LAYER_ENTITIES);
+
+            if (gameplay_drawInfo) {
+                drawRangeIndicator(
+                    towerTypeData.range[type], towerCoords.x, towerCoords.y, DRAW_LAYER_GROUND);
+            }
+        }
+    }
+
     if (gameplayMode == GAMEPLAY_MODE_TOWER_PLACE) {
         drawTowerToPlace();
     }
 
-    for (int i = 0; i < SCENE_MAX_BULLETS; i++) {
-        if (!towerBullets[i].alive) {
-            continue;
-        }
+    for (int i = 0; i < activeBulletsCount; i++) {
+        drawBullet(&towerBullets[activeBullets[i]]);
+    }
 
-        drawBullet(&towerBullets[i]);
+    for (int i = 0; i < interceptBulletsCount; i++) {
+        drawBullet(&towerBullets[interceptBullets[i]]);
     }
 }
+#endif
@@ -1,7 +1,35 @@
 #pragma once
 
+#include <stdbool.h>
+
+typedef enum {
+    TOWER_TYPE_WHITE,
+    TOWER_TYPE_BLUE,
+    TOWER_TYPE_RED,
+    TOWER_TYPE_COUNT,
+} TowerType;
+
+// How a tower picks its target among the mobs in range
+typedef enum {
+    // the most traveled
+    TARGET_STRATEGY_FIRST,
+    // the least traveled
+    TARGET_STRATEGY_LAST,
+    TARGET_STRATEGY_STRONGEST,
+    TARGET_STRATEGY_WEAKEST,
+    TARGET_STRATEGY_CLOSEST,
+    TARGET_STRATEGY_COUNT,
+} TargetStrategy;
+
+/// O(1), for hover feedback too
+bool towers_canPlace(int x, int y);
+bool towers_place(TowerType type, int x, int y);
+/// Returns false if there's no tower there
+bool towers_setTargetStrategy(int x, int y, TargetStrategy strategy);
 void towers_clear();
 void towers_handleInput();
 void towers_update(float deltaTime);
+/// Towers, range indicators and bullets, pushed to the draw list
 void towers_draw();
+/// Text and lines. After drawList_flush, so they don't split its batch
 void towers_drawInfo();
@@ -1,6 +1,9 @@
 #include "./view_mamanger.h"
+#ifndef HEADLESS
 #include "../../input/input.h"
+#endif
 #include "../../utils/utils.h"
+#include "../constants.h"
 #include <math.h>
 #include <raylib.h>
 #include <raymath.h>
@@ -19,6 +22,10 @@ Transform2D TRANSFORM = {
 
 const Transform2D *const SCENE_TRANSFORM = &TRANSFORM;
 
+int viewWidth = 0;
+int viewHeight = 0;
+
+#ifndef HEADLESS
 static void resetZoomView() {
     TRANSFORM.scale = SCENE_SCALE_INITIAL;
 }
@@ -53,9 +60,57 @@ void view_handleInput() {
         }
     }
 }
+#endif
 
 void view_update() {
     if (!Vector2Equals(TRANSFORM.previousTranslation, TRANSFORM.translation)) {
         TRANSFORM.previousTranslation = TRANSFORM.translation;
     }
 }
+
+void view_setSize(int width, int height) {
+    viewWidth = width;
+    viewHeight = height;
+}
+
+bool view_isVisible(Vector2 point, float radius) {
+    return point.x + radius >= 0 && point.x - radius <= viewWidth && point.y + radius >= 0
+           && point.y - radius <= viewHeight;
+}
+
+// Tile (x, y) spans world x from x + y to x + y + 2 half tiles, and world y from y - x - 1 to
+// y - x + 1 half tiles (see grid_coordsToWorldPoint), so what's in sight is a range of each
+
+static void getVisibleSums(int *sumMin, int *sumMax) {
+    float halfWidth = TILE_WIDTH * TRANSFORM.scale / 2.0f;
+
+    *sumMin = (int)ceilf(-TRANSFORM.translation.x / halfWidth) - 2;
+    *sumMax = (int)floorf((viewWidth - TRANSFORM.translation.x) / halfWidth);
+}
+
+static void getVisibleDifferences(int *differenceMin, int *differenceMax) {
+    float halfHeight = TILE_HEIGHT * TRANSFORM.scale / 2.0f;
+
+    *differenceMin = (int)ceilf(-TRANSFORM.translation.y / halfHeight) - 1;
+    *differenceMax = (int)floorf((viewHeight - TRANSFORM.translation.y) / halfHeight) + 1;
+}
+
+void view_getVisibleRows(int rows, int *yMin, int *yMax) {
+    int sumMin, sumMax, differenceMin, differenceMax;
+    getVisibleSums(&sumMin, &sumMax);
+    getVisibleDifferences(&differenceMin, &differenceMax);
+
+    // y = (sum + difference) / 2
+    *yMin = MAX(0, (int)floorf((sumMin + differenceMin) / 2.0f));
+    *yMax = MIN(rows - 1, (int)ceilf((sumMax + differenceMax) / 2.0f));
+}
+
+void view_getVisibleColumns(int y, int cols, int *xMin, int *xMax) {
+    int sumMin, sumMax, differenceMin, differenceMax;
+    getVisibleSums(&sumMin, &sumMax);
+    getVisibleDifferences(&differenceMin, &differenceMax);
+
+    // x = sum - y = y - difference
+    *xMin = MAX(0, MAX(sumMin - y, y - differenceMax));
+    *xMax = MIN(cols - 1, MIN(sumMax - y, y - differenceMin));
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../../utils/utils.h"
+#include <raylib.h>
+#include <stdbool.h>
 
 #define SCENE_SCALE_INITIAL 5.0f
 
@@ -8,3 +10,12 @@ extern const Transform2D *const SCENE_TRANSFORM;
 
 void view_handleInput();
 void view_update();
+
+/// Size of what the scene is drawn to, in world pixels. Once per frame, before drawing
+void view_setSize(int width, int height);
+/// Whether anything within `radius` world pixels of `point` can be in sight
+bool view_isVisible(Vector2 point, float radius);
+/// Rows of tiles with some part in sight, clamped to the grid. None if *yMin > *yMax
+void view_getVisibleRows(int rows, int *yMin, int *yMax);
+/// Tiles of row `y` with some part in sight, clamped to the grid. None if *xMin > *xMax
+void view_getVisibleColumns(int y, int cols, int *xMin, int *xMax);
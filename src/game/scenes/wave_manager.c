@@ -1,27 +1,40 @@
 #include "./wave_manager.h"
+#ifndef HEADLESS
 #include "../../core/asset_manager.h"
+#include "../../ui/ui_text_run.h"
+#include "./draw_list.h"
+#include "./view_mamanger.h"
+#endif
 #include "../../utils/grid.h"
+#include "../../utils/jobs.h"
 #include "../../utils/utils.h"
 #include "../constants.h"
 #include "../gameplay.h"
-#include "./view_mamanger.h"
+#include "./mob_movement.h"
+#include "./scene_timers.h"
+#include "./spatial_hash.h"
 #include "scene_data.h"
 #include <assert.h>
+#include <math.h>
 #include <raylib.h>
 #include <raymath.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+// Alive mobs per job of the parallel passes. A multiple of 8, for the SIMD kernels
+#define WAVE_MOBS_PER_JOB 4096
+
 typedef enum {
     MOB_STATUS_INACTIVE,
-    MOB_STATUS_WAITING_SPAWN,
     MOB_STATUS_ALIVE,
     MOB_STATUS_DEAD,
+    MOB_STATUS_ESCAPED,
 } MobStatus;
 
 typedef struct {
     const StatModifier *modifier;
-    float timeRemaining;
+    // bumped on every change, so the pending expiry of the previous one is ignored
+    unsigned int generation;
     bool isActive;
 } ModifierTimer;
 
@@ -36,20 +49,70 @@ struct {
 
 int currentWaveIndex = -1;
 
-int mobsHealth[SCENE_DATA_MAX_MOBS];
-MobType mobsTypes[SCENE_DATA_MAX_MOBS];
-int mobsWaveIndex[SCENE_DATA_MAX_MOBS];
-Vector2 mobsPosition[SCENE_DATA_MAX_MOBS];
-MobStatus mobsStatus[SCENE_DATA_MAX_MOBS];
-int mobsTargetWaypointIndex[SCENE_DATA_MAX_MOBS];
-float mobsTimeInCurrentPath[SCENE_DATA_MAX_MOBS];
+// Mobs are identified by the index they got when spawned (the `mobIndex` of the public functions),
+// which never changes. Their data lives in the packed arrays below, indexed by slot: slots
+// 0..aliveMobsCount-1 are the alive mobs, and a mob that dies or escapes is swap-removed, so loops
+// over mobs only touch live data.
+
+// All arrays have room for every mob of the scene (SCENE_DATA->mobsCount) and are allocated from
+// the scene memory by wave_initData, so they're gone when the next scene loads.
+
+// By mob index
+MobStatus *mobsStatus = NULL;
+// -1 once the mob is removed from the alive slots
+int *mobsSlot = NULL;
+// Where the mob was when removed, for the bullets still flying to it
+Vector2 *mobsLastPosition = NULL;
+// Position in dotMobs, -1 when not there
+int *mobsDotListIndex = NULL;
+
+// By slot
+int aliveMobsCount = 0;
+int *mobsIndex = NULL;
+int *mobsHealth = NULL;
+MobType *mobsTypes = NULL;
+// In tile space (see grid_getTileSpaceCenter)
+Vector2 *mobsPosition = NULL;
+int *mobsTargetWaypointIndex = NULL;
+// Tiles walked from the first waypoint. See SceneData.pathWaypointsDistance
+float *mobsDistanceTraveled = NULL;
 // Tiles that it crosses in one second
-float mobsMovementSpeed[SCENE_DATA_MAX_MOBS];
-ModifierTimer mobsModifiersTimers[SCENE_DATA_MAX_MOBS][SCENE_DATA_MAX_MOB_STAT_MODS];
-
+float *mobsMovementSpeed = NULL;
+// mobsMovementSpeed with the modifiers applied. Only refreshModifiers changes it
+float *mobsCurrentSpeed = NULL;
+// Damage taken every DOT tick, from the DOT modifiers. Only refreshModifiers changes it
+int *mobsDotDamage = NULL;
+// Segment of the path that ends in mobsTargetWaypointIndex. See MobSegments
+float *mobsSegmentStart = NULL;
+float *mobsSegmentEnd = NULL;
+float *mobsSegmentOriginX = NULL;
+float *mobsSegmentOriginY = NULL;
+float *mobsSegmentDirectionX = NULL;
+float *mobsSegmentDirectionY = NULL;
+ModifierTimer (*mobsModifiersTimers)[SCENE_DATA_MAX_MOB_STAT_MODS] = NULL;
+
+// Alive mobs by path progress, first the most traveled, as of the last wave_update. Kept from
+// one update to the next: mobs barely change places in a tick, so it's almost sorted already
+int *mobsByProgress = NULL;
+int mobsByProgressCount = 0;
+// By position in mobsByProgress
+float *mobsByProgressDistance = NULL;
+int *mobsByProgressTile = NULL;
+// Mobs from this index on haven't been added to mobsByProgress yet
+int mobsByProgressNextIndex = 0;
+
+// Alive mobs bucketed by tile. Rebuilt at the end of every wave_update, from mobsByProgress, so
+// every bucket is in progress order too
+SpatialHash mobsByTile = {0};
+
+// Alive mobs with DOT damage, so DOT ticks only visit those
+int *dotMobs = NULL;
+int dotMobsCount = 0;
+
+// Mob indexes given so far
 int totalMobsCount = 0;
-
-float spawnCooldownSeconds = 0.4f;
+int mobsKilledCount = 0;
+int mobsEscapedCount = 0;
 
 typedef enum {
     WAVE_STATUS_NOT_STARTED,
@@ -58,89 +121,131 @@ typedef enum {
 } WaveStatus;
 
 WaveStatus wavesStatus[SCENE_DATA_MAX_WAVES];
-float wavesSpawnTimers[SCENE_DATA_MAX_WAVES];
-float wavesStartTimer[SCENE_DATA_MAX_WAVES];
-float wavesMobsRemainingToSpawn[SCENE_DATA_MAX_WAVES];
+// Tick of the next spawn. Fractional, so cooldowns shorter than a tick still add up right
+double wavesNextSpawnTick[SCENE_DATA_MAX_WAVES];
+// Spawn queue: mobs don't exist until their wave spawns them
+int wavesMobsRemainingToSpawn[SCENE_DATA_MAX_WAVES];
 
-void drawMobs() {
-    char buffer[16];
+/// Caches in `slot` the segment of the path that ends in `waypointIndex`
+void setMobSegment(int slot, int waypointIndex) {
+    V2i startCoords = SCENE_DATA->pathWaypoints[waypointIndex - 1];
+    V2i endCoords = SCENE_DATA->pathWaypoints[waypointIndex];
 
-    for (int i = 0; i < totalMobsCount; i++) {
-        if (mobsStatus[i] != MOB_STATUS_ALIVE) {
-            continue;
-        }
+    Vector2 start = grid_getTileSpaceCenter(startCoords.x, startCoords.y);
+    Vector2 end = grid_getTileSpaceCenter(endCoords.x, endCoords.y);
+
+    float segmentStart = SCENE_DATA->pathWaypointsDistance[waypointIndex - 1];
+    float segmentEnd = SCENE_DATA->pathWaypointsDistance[waypointIndex];
+    float segmentLength = segmentEnd - segmentStart;
+
+    // repeated waypoints make empty segments, which mobs skip anyway
+    Vector2 direction = segmentLength > 0
+                            ? Vector2Scale(Vector2Subtract(end, start), 1 / segmentLength)
+                            : Vector2Zero();
+
+    mobsTargetWaypointIndex[slot] = waypointIndex;
+    mobsSegmentStart[slot] = segmentStart;
+    mobsSegmentEnd[slot] = segmentEnd;
+    mobsSegmentOriginX[slot] = start.x;
+    mobsSegmentOriginY[slot] = start.y;
+    mobsSegmentDirectionX[slot] = direction.x;
+    mobsSegmentDirectionY[slot] = direction.y;
+}
 
-        int mobWidth = 10;
-        int mobHeight = 10;
+void spawnMob(int waveIndex) {
+    assert(totalMobsCount < SCENE_DATA->mobsCount && "More mobs spawned than the scene has");
 
-        Vector2 drawOrigin
-            = Vector2Subtract(mobsPosition[i], (Vector2){mobWidth / 2.0f, mobHeight / 2.0f});
+    MobType type = SCENE_DATA->waves[waveIndex].mobType;
 
-        Rectangle mobRec = {
-            drawOrigin.x,
-            drawOrigin.y,
-            mobWidth,
-            mobHeight,
-        };
+    int mobIndex = totalMobsCount++;
+    int slot = aliveMobsCount++;
 
-        Color mobColor = WHITE;
+    mobsStatus[mobIndex] = MOB_STATUS_ALIVE;
+    mobsSlot[mobIndex] = slot;
 
-        switch (mobsTypes[i]) {
-        case MOB_TYPE_RED:
-            mobColor = RED;
-            break;
-        case MOB_TYPE_BLUE:
-            break;
-        case MOB_TYPE_COUNT:
-            assert(false && "Unexpected MOB_TYPE_COUNT enum value");
-            break;
-        }
+    mobsIndex[slot] = mobIndex;
+    mobsTypes[slot] = type;
+    mobsHealth[slot] = mobTypeData[type].maxHealth;
+    mobsMovementSpeed[slot] = mobTypeData[type].movementSpeed;
+    mobsCurrentSpeed[slot] = mobsMovementSpeed[slot];
+    mobsDotDamage[slot] = 0;
+    mobsDistanceTraveled[slot] = 0;
+    setMobSegment(slot, 1);
 
-        DrawRectangleRec(mobRec, mobColor);
+    // this will change when multiple spawn points is implemented
+    const V2i *coords = &SCENE_DATA->pathWaypoints[0];
+    mobsPosition[slot] = grid_getTileSpaceCenter(coords->x, coords->y);
 
-        if (gameplay_drawInfo) {
-            drawOrigin.y -= 30;
-            snprintf(buffer, 16, "%d", mobsHealth[i]);
-            DrawTextEx(uiFont, buffer, drawOrigin, 16, 1, WHITE);
-
-            drawOrigin.y += 30 + 30;
-            snprintf(buffer, 16, "%d", i);
-            DrawTextEx(uiFont, buffer, drawOrigin, 16, 1, WHITE);
-        }
+    for (int j = 0; j < SCENE_DATA_MAX_MOB_STAT_MODS; j++) {
+        mobsModifiersTimers[slot][j].modifier = NULL;
+        mobsModifiersTimers[slot][j].generation = 0;
+        mobsModifiersTimers[slot][j].isActive = false;
     }
 }
 
-void drawPath() {
-    for (int indexEnd = 1; indexEnd < SCENE_DATA->pathWaypointsCount; indexEnd++) {
-        V2i waypointStart = SCENE_DATA->pathWaypoints[indexEnd - 1];
-        V2i waypointEnd = SCENE_DATA->pathWaypoints[indexEnd];
+void addDotMob(int mobIndex) {
+    if (mobsDotListIndex[mobIndex] != -1) {
+        return;
+    }
 
-        Vector2 start = grid_getTileCenter(SCENE_TRANSFORM, waypointStart.x, waypointStart.y);
-        Vector2 end = grid_getTileCenter(SCENE_TRANSFORM, waypointEnd.x, waypointEnd.y);
+    mobsDotListIndex[mobIndex] = dotMobsCount;
+    dotMobs[dotMobsCount++] = mobIndex;
+}
+
+void removeDotMob(int mobIndex) {
+    int listIndex = mobsDotListIndex[mobIndex];
 
-        DrawLineEx(start, end, TILE_WIDTH, (Color){234, 227, 173, 100});
+    if (listIndex == -1) {
+        return;
     }
+
+    int lastMobIndex = dotMobs[--dotMobsCount];
+    dotMobs[listIndex] = lastMobIndex;
+    mobsDotListIndex[lastMobIndex] = listIndex;
+    mobsDotListIndex[mobIndex] = -1;
 }
 
-float getPathTime(int waypointIndex, float movementSpeed) {
-    if (waypointIndex == 0)
-        return 0;
+/// Swap-removes the mob in `slot`: the last alive mob takes its place
+void removeAliveMob(int slot) {
+    int mobIndex = mobsIndex[slot];
+    int lastSlot = --aliveMobsCount;
 
-    V2i startCoords = SCENE_DATA->pathWaypoints[waypointIndex - 1];
-    V2i endCoords = SCENE_DATA->pathWaypoints[waypointIndex];
+    removeDotMob(mobIndex);
 
-    int tilesX = abs(startCoords.x - endCoords.x) + 1;
-    int tilesY = abs(startCoords.y - endCoords.y) + 1;
-    int tilesScalar = tilesX == 1 ? tilesY : tilesX;
-    float pathTime = tilesScalar / movementSpeed;
+    mobsLastPosition[mobIndex] = mobsPosition[slot];
+    mobsSlot[mobIndex] = -1;
+
+    if (slot == lastSlot) {
+        return;
+    }
 
-    return pathTime;
+    mobsIndex[slot] = mobsIndex[lastSlot];
+    mobsHealth[slot] = mobsHealth[lastSlot];
+    mobsTypes[slot] = mobsTypes[lastSlot];
+    mobsPosition[slot] = mobsPosition[lastSlot];
+    mobsTargetWaypointIndex[slot] = mobsTargetWaypointIndex[lastSlot];
+    mobsDistanceTraveled[slot] = mobsDistanceTraveled[lastSlot];
+    mobsMovementSpeed[slot] = mobsMovementSpeed[lastSlot];
+    mobsCurrentSpeed[slot] = mobsCurrentSpeed[lastSlot];
+    mobsDotDamage[slot] = mobsDotDamage[lastSlot];
+    mobsSegmentStart[slot] = mobsSegmentStart[lastSlot];
+    mobsSegmentEnd[slot] = mobsSegmentEnd[lastSlot];
+    mobsSegmentOriginX[slot] = mobsSegmentOriginX[lastSlot];
+    mobsSegmentOriginY[slot] = mobsSegmentOriginY[lastSlot];
+    mobsSegmentDirectionX[slot] = mobsSegmentDirectionX[lastSlot];
+    mobsSegmentDirectionY[slot] = mobsSegmentDirectionY[lastSlot];
+
+    for (int j = 0; j < SCENE_DATA_MAX_MOB_STAT_MODS; j++) {
+        mobsModifiersTimers[slot][j] = mobsModifiersTimers[lastSlot][j];
+    }
+
+    mobsSlot[mobsIndex[slot]] = slot;
 }
 
-float applyModifiers(int mobIndex, float value, ModifierEffectType effectType) {
+float applyModifiers(int slot, float value, ModifierEffectType effectType) {
     float newValue = value;
 
-    ModifierTimer *timers = mobsModifiersTimers[mobIndex];
+    ModifierTimer *timers = mobsModifiersTimers[slot];
 
     for (int i = 0; i < SCENE_DATA_MAX_MOB_STAT_MODS; i++) {
         const StatModifier *modifier = timers[i].modifier;
@@ -169,6 +274,111 @@ float applyModifiers(int mobIndex, float value, ModifierEffectType effectType) {
     return newValue;
 }
 
+/// Recomputes the stats that depend on the modifiers of the mob. Called only when they change
+/// (added, removed or expired), so the update reads plain values
+void refreshModifiers(int slot) {
+    mobsCurrentSpeed[slot]
+        = applyModifiers(slot, mobsMovementSpeed[slot], MODIFIER_EFFECT_TYPE_SLOW);
+
+    // DOT values are the health change per DOT tick
+    mobsDotDamage[slot] = -lroundf(applyModifiers(slot, 0, MODIFIER_EFFECT_TYPE_DOT));
+
+    if (mobsDotDamage[slot] > 0) {
+        addDotMob(mobsIndex[slot]);
+    } else {
+        removeDotMob(mobsIndex[slot]);
+    }
+}
+
+/// (Re)starts the expiry of the timer, canceling the one it had
+void scheduleModifierExpiry(int mobIndex, int timerIndex) {
+    ModifierTimer *timer = &mobsModifiersTimers[mobsSlot[mobIndex]][timerIndex];
+    timer->generation++;
+
+    if (timer->modifier->durationType == DURATION_TYPE_PERMANENT) {
+        return;
+    }
+
+    SceneTimerEvent event = {
+        .type = SCENE_TIMER_MODIFIER_EXPIRE,
+        .target = mobIndex,
+        .data = timerIndex,
+        .generation = timer->generation,
+    };
+
+    sceneTimers_schedule(timer->modifier->duration, event);
+}
+
+// Scene timer handlers
+
+void onModifierExpire(SceneTimerEvent event) {
+    int slot = mobsSlot[event.target];
+
+    // gone since then
+    if (slot == -1) {
+        return;
+    }
+
+    ModifierTimer *timer = &mobsModifiersTimers[slot][event.data];
+
+    // removed or refreshed since then
+    if (!timer->isActive || timer->generation != event.generation) {
+        return;
+    }
+
+    timer->isActive = false;
+    timer->modifier = NULL;
+
+    refreshModifiers(slot);
+}
+
+void scheduleNextSpawn(int waveIndex) {
+    SceneTimerEvent event = {.type = SCENE_TIMER_WAVE_SPAWN, .target = waveIndex};
+
+    sceneTimers_scheduleAt(ceil(wavesNextSpawnTick[waveIndex]), event);
+}
+
+void onWaveSpawn(SceneTimerEvent event) {
+    int waveIndex = event.target;
+    double cooldownTicks = SCENE_DATA->waves[waveIndex].spawnCooldownSeconds
+                           * GAMEPLAY_TICKS_PER_SECOND;
+
+    // more than one per tick with short cooldowns
+    while (wavesNextSpawnTick[waveIndex] <= sceneTimers_getTick()
+           && wavesMobsRemainingToSpawn[waveIndex] > 0) {
+        spawnMob(waveIndex);
+        wavesNextSpawnTick[waveIndex] += cooldownTicks;
+        wavesMobsRemainingToSpawn[waveIndex]--;
+    }
+
+    if (wavesMobsRemainingToSpawn[waveIndex] == 0) {
+        wavesStatus[waveIndex] = WAVE_STATUS_ENDED;
+        return;
+    }
+
+    scheduleNextSpawn(waveIndex);
+}
+
+/// Hits every mob in dotMobs. The ones killed stay in the list until wave_update removes them,
+/// and wave_mob_takeDamage ignores them meanwhile
+void onDotTick(SceneTimerEvent event) {
+    for (int i = 0; i < dotMobsCount; i++) {
+        int mobIndex = dotMobs[i];
+
+        wave_mob_takeDamage(mobIndex, mobsDotDamage[mobsSlot[mobIndex]]);
+    }
+
+    sceneTimers_schedule(1.0f / GAMEPLAY_DOT_TICKS_PER_SECOND, event);
+}
+
+/// Starts the waves in order up to the one of the event. Waves started early (wave_startNext)
+/// ignore theirs
+void onWaveStart(SceneTimerEvent event) {
+    while (currentWaveIndex < event.target) {
+        wave_startNext();
+    }
+}
+
 // float getModifiedMovementSpeed(int mobIndex) {
 //     float movementSpeed = mobsMovementSpeed[mobIndex];
 //
@@ -201,12 +411,105 @@ float applyModifiers(int mobIndex, float value, ModifierEffectType effectType) {
 //     return movementSpeed;
 // }
 
+// Jobs of wave_update. Each one only writes the slots in [start, end)
+
+void advanceMobsJob(void *context, int start, int end) {
+    float deltaTime = *(const float *)context;
+
+    mobMovement_advance(
+        mobsDistanceTraveled + start, mobsCurrentSpeed + start, deltaTime, end - start);
+}
+
+void interpolateMobsJob(void *context, int start, int end) {
+    MobSegments segments = {
+        mobsSegmentStart + start,
+        mobsSegmentOriginX + start,
+        mobsSegmentOriginY + start,
+        mobsSegmentDirectionX + start,
+        mobsSegmentDirectionY + start,
+    };
+
+    mobMovement_interpolate(
+        mobsPosition + start, mobsDistanceTraveled + start, segments, end - start);
+}
+
+/// Drops the mobs removed since the last call, adds the new ones and sorts again. Insertion sort:
+/// the work is the number of mobs plus how many times one overtook another since the last call
+void sortMobsByProgress() {
+    int count = 0;
+
+    for (int i = 0; i < mobsByProgressCount; i++) {
+        int mobIndex = mobsByProgress[i];
+
+        if (mobsSlot[mobIndex] != -1) {
+            mobsByProgress[count++] = mobIndex;
+        }
+    }
+
+    // spawned after everyone else, so likely the least traveled
+    for (int mobIndex = mobsByProgressNextIndex; mobIndex < totalMobsCount; mobIndex++) {
+        if (mobsSlot[mobIndex] != -1) {
+            mobsByProgress[count++] = mobIndex;
+        }
+    }
+
+    mobsByProgressNextIndex = totalMobsCount;
+    mobsByProgressCount = count;
+
+    for (int i = 0; i < count; i++) {
+        mobsByProgressDistance[i] = mobsDistanceTraveled[mobsSlot[mobsByProgress[i]]];
+    }
+
+    for (int i = 1; i < count; i++) {
+        int mobIndex = mobsByProgress[i];
+        float distance = mobsByProgressDistance[i];
+        int j = i - 1;
+
+        while (j >= 0 && mobsByProgressDistance[j] < distance) {
+            mobsByProgress[j + 1] = mobsByProgress[j];
+            mobsByProgressDistance[j + 1] = mobsByProgressDistance[j];
+            j--;
+        }
+
+        mobsByProgress[j + 1] = mobIndex;
+        mobsByProgressDistance[j + 1] = distance;
+    }
+}
+
+void computeMobsTileJob(void *context, int start, int end) {
+    for (int i = start; i < end; i++) {
+        Vector2 position = mobsPosition[mobsSlot[mobsByProgress[i]]];
+
+        mobsByProgressTile[i] = grid_getTileIndexFromCoords(
+            SCENE_DATA->cols, SCENE_DATA->rows, (int)position.x, (int)position.y);
+    }
+}
+
+void buildMobsSpatialHash() {
+    sortMobsByProgress();
+
+    jobs_parallelFor(mobsByProgressCount, WAVE_MOBS_PER_JOB, computeMobsTileJob, NULL);
+
+    // the counting sort keeps the order of the items within a bucket
+    spatialHash_build(&mobsByTile,
+        SCENE_DATA->cols * SCENE_DATA->rows,
+        mobsByProgressTile,
+        mobsByProgress,
+        mobsByProgressCount);
+}
+
 // Public functions
 
 // Mob functions
 
 void wave_mob_removeModifier(int mobIndex, int modifierId) {
-    ModifierTimer *timers = mobsModifiersTimers[mobIndex];
+    int slot = mobsSlot[mobIndex];
+
+    if (slot == -1) {
+        return;
+    }
+
+    ModifierTimer *timers = mobsModifiersTimers[slot];
 
     for (int i = 0; i < SCENE_DATA_MAX_MOB_STAT_MODS; i++) {
         if (timers[i].modifier == NULL) {
@@ -216,20 +519,30 @@ void wave_mob_removeModifier(int mobIndex, int modifierId) {
         if (timers[i].modifier->id == modifierId) {
             timers[i].modifier = NULL;
             timers[i].isActive = false;
+            // cancels the expiry
+            timers[i].generation++;
+            refreshModifiers(slot);
             return;
         }
     }
 }
 
 void wave_mob_addModifier(int mobIndex, const StatModifier *modifierData) {
+    int slot = mobsSlot[mobIndex];
+
+    if (slot == -1) {
+        return;
+    }
+
     int availableSlotIndex = -1;
 
-    ModifierTimer *timers = mobsModifiersTimers[mobIndex];
+    ModifierTimer *timers = mobsModifiersTimers[slot];
 
     for (int i = 0; i < SCENE_DATA_MAX_MOB_STAT_MODS; i++) {
         if (timers[i].isActive && timers[i].modifier->id == modifierData->id) {
             // refresh timer and exit
-            timers[i].timeRemaining = modifierData->duration;
+            scheduleModifierExpiry(mobIndex, i);
+            refreshModifiers(slot);
             return;
         }
 
@@ -246,247 +559,451 @@ void wave_mob_addModifier(int mobIndex, const StatModifier *modifierData) {
     if (availableSlotIndex != -1) {
         timers[availableSlotIndex].isActive = true;
         timers[availableSlotIndex].modifier = modifierData;
-        timers[availableSlotIndex].timeRemaining = modifierData->duration;
+        scheduleModifierExpiry(mobIndex, availableSlotIndex);
+        refreshModifiers(slot);
     }
 }
 
 int wave_mob_isAlive(int mobIndex) {
+    if (mobIndex < 0 || mobIndex >= totalMobsCount) {
+        return false;
+    }
+
     return mobsStatus[mobIndex] == MOB_STATUS_ALIVE;
 }
 
+/// For mobs that are no longer alive, the last position they had
 Vector2 wave_mob_getPosition(int mobIndex) {
-    return mobsPosition[mobIndex];
+    int slot = mobsSlot[mobIndex];
+
+    return slot != -1 ? mobsPosition[slot] : mobsLastPosition[mobIndex];
 }
 
+/// A mob killed here keeps its slot until the next wave_update, so the slots (and the spatial hash)
+/// stay put while towers and bullets update
 void wave_mob_takeDamage(int mobIndex, int damage) {
-    mobsHealth[mobIndex] -= damage;
+    if (mobsStatus[mobIndex] != MOB_STATUS_ALIVE) {
+        return;
+    }
 
-    if (mobsHealth[mobIndex] <= 0) {
+    int slot = mobsSlot[mobIndex];
+    mobsHealth[slot] -= damage;
+
+    if (mobsHealth[slot] <= 0) {
         mobsStatus[mobIndex] = MOB_STATUS_DEAD;
+        mobsKilledCount++;
     }
 }
 
+/// Only meaningful for alive mobs
+float wave_mob_getDistanceTraveled(int mobIndex) {
+    return mobsDistanceTraveled[mobsSlot[mobIndex]];
+}
+
+int wave_mob_getHealth(int mobIndex) {
+    return mobsHealth[mobsSlot[mobIndex]];
+}
+
+/// Only meaningful for alive mobs
 float wave_mob_getPercentajeTraveled(int mobIndex) {
-    float totalTime = 0;
-    float timeTraveled = 0;
+    return wave_mob_getDistanceTraveled(mobIndex) * 100 / SCENE_DATA->pathLength;
+}
 
-    for (int i = 0; i < SCENE_DATA->pathWaypointsCount; i++) {
-        if (i == 0) {
-            continue;
+/// Smallest root of a*t^2 + b*t + c in [tMin, tMax], or -1
+static float getFirstRootInRange(float a, float b, float c, float tMin, float tMax) {
+    float roots[2];
+    int rootsCount = 0;
+
+    if (fabsf(a) < 1e-6f) {
+        if (fabsf(b) < 1e-6f) {
+            return -1;
         }
 
-        totalTime += getPathTime(i, mobsMovementSpeed[mobIndex]);
+        roots[rootsCount++] = -c / b;
+    } else {
+        float discriminant = b * b - 4 * a * c;
 
-        if (mobsTargetWaypointIndex[mobIndex] == i) {
-            timeTraveled += mobsTimeInCurrentPath[mobIndex];
-            continue;
+        if (discriminant < 0) {
+            return -1;
         }
 
-        if (mobsTargetWaypointIndex[mobIndex] < i) {
-            continue;
+        float sqrtDiscriminant = sqrtf(discriminant);
+        float t1 = (-b - sqrtDiscriminant) / (2 * a);
+        float t2 = (-b + sqrtDiscriminant) / (2 * a);
+
+        roots[rootsCount++] = MIN(t1, t2);
+        roots[rootsCount++] = MAX(t1, t2);
+    }
+
+    for (int i = 0; i < rootsCount; i++) {
+        if (roots[i] >= tMin && roots[i] <= tMax) {
+            return roots[i];
         }
+    }
 
-        timeTraveled = totalTime;
+    return -1;
+}
+
+/// Seconds until a projectile fired now from `origin` at `projectileSpeed` (tiles per second)
+/// meets the mob, assuming it keeps its current speed. Solved segment by segment along the rest of
+/// its path. False if the mob isn't alive or it escapes first
+bool wave_mob_getInterceptTime(
+    int mobIndex, Vector2 origin, float projectileSpeed, float *seconds) {
+    if (!wave_mob_isAlive(mobIndex)) {
+        return false;
     }
 
-    float percentageTraveled = timeTraveled * 100 / totalTime;
+    int slot = mobsSlot[mobIndex];
+    float speed = mobsCurrentSpeed[slot];
+    float distance = mobsDistanceTraveled[slot];
+    float segmentTimeStart = 0;
+
+    for (int w = mobsTargetWaypointIndex[slot]; w < SCENE_DATA->pathWaypointsCount; w++) {
+        V2i startCoords = SCENE_DATA->pathWaypoints[w - 1];
+        V2i endCoords = SCENE_DATA->pathWaypoints[w];
+        float segmentStart = SCENE_DATA->pathWaypointsDistance[w - 1];
+        float segmentEnd = SCENE_DATA->pathWaypointsDistance[w];
+
+        if (segmentEnd <= segmentStart) {
+            continue;
+        }
+
+        Vector2 start = grid_getTileSpaceCenter(startCoords.x, startCoords.y);
+        Vector2 end = grid_getTileSpaceCenter(endCoords.x, endCoords.y);
+        Vector2 direction
+            = Vector2Scale(Vector2Subtract(end, start), 1 / (segmentEnd - segmentStart));
+
+        // mob at time t: where it would have been at t = 0 on this segment's line, plus velocity
+        Vector2 positionAtZero
+            = Vector2Add(start, Vector2Scale(direction, distance - segmentStart));
+        Vector2 velocity = Vector2Scale(direction, speed);
+        Vector2 fromOrigin = Vector2Subtract(positionAtZero, origin);
 
-    return percentageTraveled;
+        // |fromOrigin + velocity * t| = projectileSpeed * t
+        float a = Vector2DotProduct(velocity, velocity) - projectileSpeed * projectileSpeed;
+        float b = 2 * Vector2DotProduct(fromOrigin, velocity);
+        float c = Vector2DotProduct(fromOrigin, fromOrigin);
+
+        float segmentTimeEnd = speed > 0 ? (segmentEnd - distance) / speed : INFINITY;
+        float t = getFirstRootInRange(a, b, c, segmentTimeStart, segmentTimeEnd);
+
+        if (t >= 0) {
+            *seconds = t;
+            return true;
+        }
+
+        segmentTimeStart = segmentTimeEnd;
+    }
+
+    return false;
 }
 
 int wave_getMobCount() {
     return totalMobsCount;
 }
 
+/// Returns how many alive mobs there were at the end of the last wave_update, and points
+/// `mobIndices` to them, first the most traveled, and `distances` to how much they traveled.
+/// Mobs killed since then are still listed
+int wave_getMobsByProgress(const int **mobIndices, const float **distances) {
+    *mobIndices = mobsByProgress;
+    *distances = mobsByProgressDistance;
+
+    return mobsByProgressCount;
+}
+
+/// Returns how many alive mobs were on the tile at the end of the last wave_update, and points
+/// `mobIndices` to them, first the most traveled. Mobs killed since then are still listed
+int wave_getMobsInTile(int tileX, int tileY, const int **mobIndices) {
+    int tileIndex = grid_getTileIndexFromCoords(SCENE_DATA->cols, SCENE_DATA->rows, tileX, tileY);
+
+    if (tileIndex == -1) {
+        *mobIndices = NULL;
+        return 0;
+    }
+
+    return spatialHash_getCellItems(&mobsByTile, tileIndex, mobIndices);
+}
+
+int wave_getKilledCount() {
+    return mobsKilledCount;
+}
+
+int wave_getEscapedCount() {
+    return mobsEscapedCount;
+}
+
+/// True when every wave spawned all its mobs and none of them is still walking
+bool wave_isSceneCleared() {
+    for (int i = 0; i < SCENE_DATA->wavesCount; i++) {
+        if (wavesStatus[i] != WAVE_STATUS_ENDED) {
+            return false;
+        }
+    }
+
+    return aliveMobsCount == 0;
+}
+
 bool wave_isPath(int tileX, int tileY) {
-    for (int indexEnd = 1; indexEnd < SCENE_DATA->pathWaypointsCount; indexEnd++) {
-        V2i waypointStart = SCENE_DATA->pathWaypoints[indexEnd - 1];
-        V2i waypointEnd = SCENE_DATA->pathWaypoints[indexEnd];
+    return scene_data_getTileFlags(tileX, tileY) & SCENE_TILE_PATH;
+}
 
-        if (waypointStart.x <= tileX && tileX <= waypointEnd.x && waypointStart.y <= tileY
-            && tileY <= waypointEnd.y) {
-            return true;
+/// Fills `intervals` (room for WAVE_MAX_PATH_INTERVALS) with the stretches of the path within
+/// `range` of `center`, in order, and returns how many. Both in tile space
+int wave_getPathIntervalsInRange(Vector2 center, float range, PathInterval *intervals) {
+    int count = 0;
+
+    for (int w = 1; w < SCENE_DATA->pathWaypointsCount; w++) {
+        V2i startCoords = SCENE_DATA->pathWaypoints[w - 1];
+        V2i endCoords = SCENE_DATA->pathWaypoints[w];
+        float segmentStart = SCENE_DATA->pathWaypointsDistance[w - 1];
+        float segmentLength = SCENE_DATA->pathWaypointsDistance[w] - segmentStart;
+
+        if (segmentLength <= 0) {
+            continue;
+        }
+
+        Vector2 start = grid_getTileSpaceCenter(startCoords.x, startCoords.y);
+        Vector2 end = grid_getTileSpaceCenter(endCoords.x, endCoords.y);
+        Vector2 direction = Vector2Scale(Vector2Subtract(end, start), 1 / segmentLength);
+        Vector2 fromCenter = Vector2Subtract(start, center);
+
+        // |fromCenter + direction * t| <= range, with |direction| = 1
+        float b = Vector2DotProduct(fromCenter, direction);
+        float c = Vector2DotProduct(fromCenter, fromCenter) - range * range;
+        float discriminant = b * b - c;
+
+        if (discriminant < 0) {
+            continue;
+        }
+
+        float root = sqrtf(discriminant);
+        float t0 = MAX(-b - root, 0);
+        float t1 = MIN(-b + root, segmentLength);
+
+        if (t0 > t1) {
+            continue;
+        }
+
+        PathInterval interval = {segmentStart + t0, segmentStart + t1};
+
+        // goes on from the last one, through a waypoint
+        if (count > 0 && intervals[count - 1].end >= interval.start) {
+            intervals[count - 1].end = interval.end;
+            continue;
         }
+
+        intervals[count++] = interval;
     }
 
-    return false;
+    return count;
+}
+
+void allocateMobs(int capacity) {
+    mobsStatus = scene_data_alloc(sizeof(*mobsStatus) * capacity);
+    mobsSlot = scene_data_alloc(sizeof(*mobsSlot) * capacity);
+    mobsLastPosition = scene_data_alloc(sizeof(*mobsLastPosition) * capacity);
+    mobsDotListIndex = scene_data_alloc(sizeof(*mobsDotListIndex) * capacity);
+    dotMobs = scene_data_alloc(sizeof(*dotMobs) * capacity);
+
+    mobsIndex = scene_data_alloc(sizeof(*mobsIndex) * capacity);
+    mobsHealth = scene_data_alloc(sizeof(*mobsHealth) * capacity);
+    mobsTypes = scene_data_alloc(sizeof(*mobsTypes) * capacity);
+    mobsPosition = scene_data_alloc(sizeof(*mobsPosition) * capacity);
+    mobsTargetWaypointIndex = scene_data_alloc(sizeof(*mobsTargetWaypointIndex) * capacity);
+    mobsDistanceTraveled = scene_data_alloc(sizeof(*mobsDistanceTraveled) * capacity);
+    mobsMovementSpeed = scene_data_alloc(sizeof(*mobsMovementSpeed) * capacity);
+    mobsCurrentSpeed = scene_data_alloc(sizeof(*mobsCurrentSpeed) * capacity);
+    mobsDotDamage = scene_data_alloc(sizeof(*mobsDotDamage) * capacity);
+    mobsSegmentStart = scene_data_alloc(sizeof(*mobsSegmentStart) * capacity);
+    mobsSegmentEnd = scene_data_alloc(sizeof(*mobsSegmentEnd) * capacity);
+    mobsSegmentOriginX = scene_data_alloc(sizeof(*mobsSegmentOriginX) * capacity);
+    mobsSegmentOriginY = scene_data_alloc(sizeof(*mobsSegmentOriginY) * capacity);
+    mobsSegmentDirectionX = scene_data_alloc(sizeof(*mobsSegmentDirectionX) * capacity);
+    mobsSegmentDirectionY = scene_data_alloc(sizeof(*mobsSegmentDirectionY) * capacity);
+    mobsModifiersTimers = scene_data_alloc(sizeof(*mobsModifiersTimers) * capacity);
+    mobsByProgress = scene_data_alloc(sizeof(*mobsByProgress) * capacity);
+    mobsByProgressDistance = scene_data_alloc(sizeof(*mobsByProgressDistance) * capacity);
+    mobsByProgressTile = scene_data_alloc(sizeof(*mobsByProgressTile) * capacity);
 }
 
 void wave_initData() {
     currentWaveIndex = -1;
     totalMobsCount = 0;
+    aliveMobsCount = 0;
+    dotMobsCount = 0;
+    mobsByProgressCount = 0;
+    mobsByProgressNextIndex = 0;
+    mobsKilledCount = 0;
+    mobsEscapedCount = 0;
 
-    for (int i = 0; i < SCENE_DATA_MAX_MOBS; i++) {
+    allocateMobs(SCENE_DATA->mobsCount);
+
+    for (int i = 0; i < SCENE_DATA->mobsCount; i++) {
         mobsStatus[i] = MOB_STATUS_INACTIVE;
-        mobsPosition[i] = Vector2Zero();
-        mobsWaveIndex[i] = -1;
+        mobsSlot[i] = -1;
+        mobsLastPosition[i] = Vector2Zero();
+        mobsDotListIndex[i] = -1;
     }
 
     for (int i = 0; i < SCENE_DATA_MAX_WAVES; i++) {
         const WaveData *currentWave = &SCENE_DATA->waves[i];
 
-        wavesSpawnTimers[i] = spawnCooldownSeconds;
+        wavesNextSpawnTick[i] = 0;
         wavesStatus[i] = WAVE_STATUS_NOT_STARTED;
-        wavesStartTimer[i] = currentWave->startDelaySeconds;
         wavesMobsRemainingToSpawn[i] = currentWave->mobsCount;
+    }
 
-        int oldMobsCount = totalMobsCount;
-        totalMobsCount += currentWave->mobsCount;
-
-        for (int i = oldMobsCount; i < totalMobsCount; i++) {
-            mobsStatus[i] = MOB_STATUS_WAITING_SPAWN;
-            mobsTypes[i] = currentWave->mobType;
-            mobsHealth[i] = mobTypeData[currentWave->mobType].maxHealth;
-            mobsWaveIndex[i] = currentWaveIndex;
-            mobsMovementSpeed[i] = mobTypeData[currentWave->mobType].movementSpeed;
-            mobsTimeInCurrentPath[i] = 0;
-            mobsTargetWaypointIndex[i] = 1;
-
-            // this will change when multiple spawn points is implemented
-            const V2i *coords = &SCENE_DATA->pathWaypoints[0];
-            mobsPosition[i] = grid_getTileCenter(SCENE_TRANSFORM, coords->x, coords->y);
-
-            // modifiers
-            for (int j = 0; j < SCENE_DATA_MAX_MOB_STAT_MODS; j++) {
-                mobsModifiersTimers[i][j].modifier = NULL;
-                mobsModifiersTimers[i][j].timeRemaining = 0;
-                mobsModifiersTimers[i][j].isActive = false;
-            }
-        }
+    sceneTimers_setHandler(SCENE_TIMER_WAVE_START, onWaveStart);
+    sceneTimers_setHandler(SCENE_TIMER_WAVE_SPAWN, onWaveSpawn);
+    sceneTimers_setHandler(SCENE_TIMER_MODIFIER_EXPIRE, onModifierExpire);
+    sceneTimers_setHandler(SCENE_TIMER_DOT_TICK, onDotTick);
+
+    sceneTimers_schedule(
+        1.0f / GAMEPLAY_DOT_TICKS_PER_SECOND, (SceneTimerEvent){.type = SCENE_TIMER_DOT_TICK});
+
+    // all delays count from now
+    for (int i = 0; i < SCENE_DATA->wavesCount; i++) {
+        SceneTimerEvent event = {.type = SCENE_TIMER_WAVE_START, .target = i};
+        sceneTimers_schedule(SCENE_DATA->waves[i].startDelaySeconds, event);
     }
+
+    buildMobsSpatialHash();
 }
 
 void wave_startNext() {
-    if (currentWaveIndex >= SCENE_DATA->wavesCount) {
+    if (currentWaveIndex + 1 >= SCENE_DATA->wavesCount) {
         // LOG? no more waves
         return;
     }
 
     currentWaveIndex += 1;
 
-    wavesStatus[currentWaveIndex] = WAVE_STATUS_STARTED;
-    wavesSpawnTimers[currentWaveIndex] = spawnCooldownSeconds;
-    wavesStartTimer[currentWaveIndex] = SCENE_DATA->waves[currentWaveIndex].startDelaySeconds;
-
-    const WaveData *currentWave = &SCENE_DATA->waves[currentWaveIndex];
-
-    int oldMobsCount = totalMobsCount;
+    const WaveData *wave = &SCENE_DATA->waves[currentWaveIndex];
 
-    totalMobsCount += currentWave->mobsCount;
+    if (wave->mobsCount == 0) {
+        wavesStatus[currentWaveIndex] = WAVE_STATUS_ENDED;
+        return;
+    }
 
-    for (int i = oldMobsCount; i < totalMobsCount; i++) {
-        mobsStatus[i] = MOB_STATUS_WAITING_SPAWN;
-        mobsTypes[i] = currentWave->mobType;
-        mobsHealth[i] = mobTypeData[currentWave->mobType].maxHealth;
-        mobsWaveIndex[i] = currentWaveIndex;
-        mobsMovementSpeed[i] = mobTypeData[currentWave->mobType].movementSpeed;
-        mobsTimeInCurrentPath[i] = 0;
-        mobsTargetWaypointIndex[i] = 1;
+    wavesStatus[currentWaveIndex] = WAVE_STATUS_STARTED;
+    wavesNextSpawnTick[currentWaveIndex]
+        = sceneTimers_getTick() + (double)wave->spawnCooldownSeconds * GAMEPLAY_TICKS_PER_SECOND;
 
-        const V2i *coords = &SCENE_DATA->pathWaypoints[0];
-        mobsPosition[i] = grid_getTileCenter(SCENE_TRANSFORM, coords->x, coords->y);
-    }
+    scheduleNextSpawn(currentWaveIndex);
 }
 
+// Waves and modifier expiry run on the scene timers, advanced before this
 void wave_update(float deltaTime) {
-    for (int i = 0; i < SCENE_DATA->wavesCount; i++) {
-        // TODO: switch?
-        if (wavesStatus[i] == WAVE_STATUS_ENDED) {
+    // drop the killed ones
+    int slot = 0;
+
+    while (slot < aliveMobsCount) {
+        int mobIndex = mobsIndex[slot];
+
+        // killed since the last update
+        if (mobsStatus[mobIndex] != MOB_STATUS_ALIVE) {
+            removeAliveMob(slot);
             continue;
         }
 
-        if (wavesStatus[i] == WAVE_STATUS_NOT_STARTED) {
-            wavesStartTimer[i] -= deltaTime;
+        slot++;
+    }
+
+    jobs_parallelFor(aliveMobsCount, WAVE_MOBS_PER_JOB, advanceMobsJob, &deltaTime);
 
-            if (wavesStartTimer[i] <= 0) {
-                wave_startNext();
-            }
+    // the few that reached the end of their segment
+    slot = 0;
 
+    while (slot < aliveMobsCount) {
+        if (mobsDistanceTraveled[slot] < mobsSegmentEnd[slot]) {
+            slot++;
             continue;
         }
 
-        if (wavesStatus[i] == WAVE_STATUS_STARTED) {
-            if (wavesMobsRemainingToSpawn[i] == 0) {
-                wavesStatus[i] = WAVE_STATUS_ENDED;
-            }
-
-            wavesSpawnTimers[i] -= deltaTime;
+        if (mobsDistanceTraveled[slot] >= SCENE_DATA->pathLength) {
+            mobsStatus[mobsIndex[slot]] = MOB_STATUS_ESCAPED;
+            mobsEscapedCount++;
+            removeAliveMob(slot);
+            continue;
         }
-    }
 
-    for (int i = 0; i < totalMobsCount; i++) {
-        int waveIndex = mobsWaveIndex[i];
+        // a waypoint can be skipped in one tick if the segment is short enough
+        int waypointIndex = mobsTargetWaypointIndex[slot];
 
-        if (mobsStatus[i] == MOB_STATUS_WAITING_SPAWN && wavesSpawnTimers[waveIndex] <= 0) {
-            mobsStatus[i] = MOB_STATUS_ALIVE;
-            wavesSpawnTimers[waveIndex] += spawnCooldownSeconds;
-            wavesMobsRemainingToSpawn[waveIndex]--;
+        while (mobsDistanceTraveled[slot] >= SCENE_DATA->pathWaypointsDistance[waypointIndex]) {
+            waypointIndex++;
         }
 
-        if (mobsStatus[i] == MOB_STATUS_ALIVE) {
-            int waypointIndex = mobsTargetWaypointIndex[i];
-            V2i waypointCoords = SCENE_DATA->pathWaypoints[waypointIndex];
-            Vector2 waypointPos
-                = grid_getTileCenter(SCENE_TRANSFORM, waypointCoords.x, waypointCoords.y);
-
-            V2i prevWaypointCoords = SCENE_DATA->pathWaypoints[waypointIndex - 1];
-            Vector2 prevWaypointPos
-                = grid_getTileCenter(SCENE_TRANSFORM, prevWaypointCoords.x, prevWaypointCoords.y);
+        setMobSegment(slot, waypointIndex);
+        slot++;
+    }
 
-            float pathTime = getPathTime(waypointIndex, mobsMovementSpeed[i]);
+    jobs_parallelFor(aliveMobsCount, WAVE_MOBS_PER_JOB, interpolateMobsJob, NULL);
 
-            mobsTimeInCurrentPath[i] += applyModifiers(i, deltaTime, MODIFIER_EFFECT_TYPE_SLOW);
-            mobsTimeInCurrentPath[i] = Clamp(mobsTimeInCurrentPath[i], 0, pathTime);
+    buildMobsSpatialHash();
+}
 
-            float t = mobsTimeInCurrentPath[i] / pathTime;
-            mobsPosition[i] = Vector2Lerp(prevWaypointPos, waypointPos, t);
+#ifndef HEADLESS
+// ------
+// DRAW -
 
-            Vector2 posMin = {
-                MIN(prevWaypointPos.x, waypointPos.x),
-                MIN(prevWaypointPos.y, waypointPos.y),
-            };
+// Index by MobType
+const Color mobColors[MOB_TYPE_COUNT] = {RED, WHITE};
 
-            Vector2 posMax = {
-                MAX(prevWaypointPos.x, waypointPos.x),
-                MAX(prevWaypointPos.y, waypointPos.y),
-            };
+void drawMobs() {
+    // half of the side, in pixels
+    const Vector2 mobDrawRadius = {5, 5};
 
-            mobsPosition[i] = Vector2Clamp(mobsPosition[i], posMin, posMax);
+    for (int i = 0; i < aliveMobsCount; i++) {
+        if (mobsStatus[mobsIndex[i]] != MOB_STATUS_ALIVE) {
+            continue;
+        }
 
-            if (mobsTimeInCurrentPath[i] >= pathTime) {
-                if (mobsTargetWaypointIndex[i] == SCENE_DATA->pathWaypointsCount - 1) {
-                    mobsStatus[i] = MOB_STATUS_INACTIVE;
-                    continue;
-                }
+        Vector2 mobPos = grid_tileSpaceToWorldPoint(SCENE_TRANSFORM, mobsPosition[i]);
 
-                mobsTargetWaypointIndex[i]++;
-                mobsTimeInCurrentPath[i] = 0;
-            }
+        if (!view_isVisible(mobPos, mobDrawRadius.x)) {
+            continue;
+        }
 
-            for (int timerIndex = 0; timerIndex < SCENE_DATA_MAX_MOB_STAT_MODS; timerIndex++) {
-                ModifierTimer *timer = &mobsModifiersTimers[i][timerIndex];
+        drawList_push(DRAW_LAYER_ENTITIES,
+            drawList_getDepth(mobsPosition[i]),
+            SPRITE_SQUARE,
+            mobPos,
+            mobDrawRadius,
+            mobColors[mobsTypes[i]]);
+    }
+}
 
-                if (timer == NULL || !timer->isActive) {
-                    continue;
-                }
+/// Health and index of every mob
+void wave_drawInfo() {
+    // laid out once, then only compared
+    static UITextRun digits = {0};
+    uiTextRun_set(&digits, uiFont, 16, 1, UI_TEXT_RUN_DIGITS);
 
-                if (timer->modifier->durationType == DURATION_TYPE_PERMANENT) {
-                    continue;
-                }
+    for (int i = 0; i < aliveMobsCount; i++) {
+        if (mobsStatus[mobsIndex[i]] != MOB_STATUS_ALIVE) {
+            continue;
+        }
 
-                timer->timeRemaining -= deltaTime;
+        Vector2 mobPos = grid_tileSpaceToWorldPoint(SCENE_TRANSFORM, mobsPosition[i]);
 
-                if (timer->timeRemaining <= 0) {
-                    timer->isActive = false;
-                    timer->timeRemaining = 0;
-                }
-            }
+        // the text goes above and below it
+        if (!view_isVisible(mobPos, 50)) {
+            continue;
         }
+
+        Vector2 drawOrigin = Vector2Subtract(mobPos, (Vector2){5, 5});
+
+        drawOrigin.y -= 30;
+        uiTextRun_drawNumber(&digits, mobsHealth[i], drawOrigin, WHITE);
+
+        drawOrigin.y += 30 + 30;
+        uiTextRun_drawNumber(&digits, mobsIndex[i], drawOrigin, WHITE);
     }
 }
 
 void wave_draw() {
-    // for debug. Eventually, path will have a different sprite
-    drawPath();
     drawMobs();
 }
+#endif
@@ -3,8 +3,22 @@
 #include <raylib.h>
 #include <stdbool.h>
 
+// Stretch of the path, in distance from the first waypoint. See SceneData.pathWaypointsDistance
+typedef struct {
+    float start;
+    float end;
+} PathInterval;
+
+// A circle can't cover more stretches than the path has segments
+#define WAVE_MAX_PATH_INTERVALS (SCENE_DATA_MAX_WAYPOINTS - 1)
+
 // utils
 int wave_getMobCount();
+int wave_getMobsByProgress(const int **mobIndices, const float **distances);
+int wave_getMobsInTile(int tileX, int tileY, const int **mobIndices);
+int wave_getKilledCount();
+int wave_getEscapedCount();
+bool wave_isSceneCleared();
 
 // utils - mob
 void wave_mob_removeModifier(int mobIndex, int modifierId);
@@ -12,10 +26,14 @@ void wave_mob_addModifier(int mobIndex, const StatModifier *modifierData);
 int wave_mob_isAlive(int mobIndex);
 Vector2 wave_mob_getPosition(int mobIndex);
 void wave_mob_takeDamage(int mobIndex, int damage);
+float wave_mob_getDistanceTraveled(int mobIndex);
+int wave_mob_getHealth(int mobIndex);
 float wave_mob_getPercentajeTraveled(int mobIndex);
+bool wave_mob_getInterceptTime(int mobIndex, Vector2 origin, float projectileSpeed, float *seconds);
 
 // utils - path
 bool wave_isPath(int tileX, int tileY);
+int wave_getPathIntervalsInRange(Vector2 center, float range, PathInterval *intervals);
 
 // lifecycle
 void wave_initData();
@@ -23,5 +41,7 @@ void wave_startNext();
 void wave_update(float deltaTime);
 
 // draw
+/// Pushed to the draw list
 void wave_draw();
+/// Text. After drawList_flush, so it doesn't split its batch
 void wave_drawInfo();
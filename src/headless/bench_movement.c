@@ -0,0 +1,192 @@
+// Benchmark of the mob movement kernels. Built and run with `make bench`.
+// Compares, on a synthetic path:
+// - per mob: the old update, looking up the segment and lerping between its waypoints
+// - scalar: the kernels of mob_movement.c in plain C
+// - simd: the same kernels with the instruction set the build targets
+#include "../game/scenes/mob_movement.h"
+#include <math.h>
+#include <raymath.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_WAYPOINTS_COUNT 10
+#define BENCH_MOB_STEPS 200000000L
+
+typedef struct {
+    int count;
+    float *distances;
+    float *speeds;
+    int *targetWaypoints;
+    Vector2 *positions;
+    float *segmentStart;
+    float *segmentOriginX;
+    float *segmentOriginY;
+    float *segmentDirectionX;
+    float *segmentDirectionY;
+} BenchMobs;
+
+Vector2 waypoints[BENCH_WAYPOINTS_COUNT];
+float waypointsDistance[BENCH_WAYPOINTS_COUNT];
+
+static double getWallSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+/// Zigzag over a 100x100 grid, like scene 3
+static void buildPath() {
+    for (int i = 0; i < BENCH_WAYPOINTS_COUNT; i++) {
+        waypoints[i] = (Vector2){(i / 2) * 20 + 1.5f, (i % 4 == 1 || i % 4 == 2) ? 98.5f : 0.5f};
+        waypointsDistance[i] = i == 0 ? 0
+                                      : waypointsDistance[i - 1]
+                                            + Vector2Distance(waypoints[i - 1], waypoints[i]);
+    }
+}
+
+/// Every mob somewhere along the path, so all segments are used
+static void resetMobs(BenchMobs *mobs) {
+    float pathLength = waypointsDistance[BENCH_WAYPOINTS_COUNT - 1];
+    srand(1);
+
+    for (int i = 0; i < mobs->count; i++) {
+        mobs->distances[i] = pathLength * 0.5f * rand() / RAND_MAX;
+        mobs->speeds[i] = 1 + (float)rand() / RAND_MAX;
+
+        int w = 1;
+        while (mobs->distances[i] >= waypointsDistance[w]) {
+            w++;
+        }
+
+        Vector2 direction = Vector2Normalize(Vector2Subtract(waypoints[w], waypoints[w - 1]));
+
+        mobs->targetWaypoints[i] = w;
+        mobs->segmentStart[i] = waypointsDistance[w - 1];
+        mobs->segmentOriginX[i] = waypoints[w - 1].x;
+        mobs->segmentOriginY[i] = waypoints[w - 1].y;
+        mobs->segmentDirectionX[i] = direction.x;
+        mobs->segmentDirectionY[i] = direction.y;
+    }
+}
+
+static void allocMobs(BenchMobs *mobs, int count) {
+    mobs->count = count;
+    mobs->distances = malloc(sizeof(float) * count);
+    mobs->speeds = malloc(sizeof(float) * count);
+    mobs->targetWaypoints = malloc(sizeof(int) * count);
+    mobs->positions = malloc(sizeof(Vector2) * count);
+    mobs->segmentStart = malloc(sizeof(float) * count);
+    mobs->segmentOriginX = malloc(sizeof(float) * count);
+    mobs->segmentOriginY = malloc(sizeof(float) * count);
+    mobs->segmentDirectionX = malloc(sizeof(float) * count);
+    mobs->segmentDirectionY = malloc(sizeof(float) * count);
+}
+
+static void freeMobs(BenchMobs *mobs) {
+    free(mobs->distances);
+    free(mobs->speeds);
+    free(mobs->targetWaypoints);
+    free(mobs->positions);
+    free(mobs->segmentStart);
+    free(mobs->segmentOriginX);
+    free(mobs->segmentOriginY);
+    free(mobs->segmentDirectionX);
+    free(mobs->segmentDirectionY);
+}
+
+static void stepPerMob(BenchMobs *mobs, float deltaTime) {
+    for (int i = 0; i < mobs->count; i++) {
+        mobs->distances[i] += mobs->speeds[i] * deltaTime;
+
+        int w = mobs->targetWaypoints[i];
+        float t = (mobs->distances[i] - waypointsDistance[w - 1])
+                  / (waypointsDistance[w] - waypointsDistance[w - 1]);
+
+        mobs->positions[i] = Vector2Lerp(waypoints[w - 1], waypoints[w], Clamp(t, 0, 1));
+    }
+}
+
+static void stepKernels(BenchMobs *mobs, float deltaTime, bool simd) {
+    MobSegments segments = {
+        mobs->segmentStart,
+        mobs->segmentOriginX,
+        mobs->segmentOriginY,
+        mobs->segmentDirectionX,
+        mobs->segmentDirectionY,
+    };
+
+    if (simd) {
+        mobMovement_advance(mobs->distances, mobs->speeds, deltaTime, mobs->count);
+        mobMovement_interpolate(mobs->positions, mobs->distances, segments, mobs->count);
+    } else {
+        mobMovement_advanceScalar(mobs->distances, mobs->speeds, deltaTime, mobs->count);
+        mobMovement_interpolateScalar(mobs->positions, mobs->distances, segments, mobs->count);
+    }
+}
+
+/// Nanoseconds per mob and tick. `mode`: 0 per mob, 1 scalar, 2 simd
+static double run(BenchMobs *mobs, int mode, double *checksum) {
+    resetMobs(mobs);
+
+    long ticks = BENCH_MOB_STEPS / mobs->count;
+    double start = getWallSeconds();
+
+    for (long t = 0; t < ticks; t++) {
+        // back and forth, so they stay on their segment and the three stay comparable
+        float deltaTime = t % 2 == 0 ? 1 / 60.0f : -1 / 60.0f;
+
+        if (mode == 0) {
+            stepPerMob(mobs, deltaTime);
+        } else {
+            stepKernels(mobs, deltaTime, mode == 2);
+        }
+    }
+
+    double elapsed = getWallSeconds() - start;
+
+    *checksum = 0;
+    for (int i = 0; i < mobs->count; i++) {
+        *checksum += mobs->positions[i].x + mobs->positions[i].y;
+    }
+
+    return elapsed * 1e9 / ((double)ticks * mobs->count);
+}
+
+int main() {
+    int counts[] = {10000, 100000, 1000000};
+
+    buildPath();
+
+    printf("Mob movement, %s build\n", mobMovement_getInstructionSet());
+    printf("%10s %12s %12s %12s %10s\n", "mobs", "per mob", "scalar", "simd", "speedup");
+
+    for (int i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++) {
+        BenchMobs mobs;
+        allocMobs(&mobs, counts[i]);
+
+        double checksums[3];
+        double perMob = run(&mobs, 0, &checksums[0]);
+        double scalar = run(&mobs, 1, &checksums[1]);
+        double simd = run(&mobs, 2, &checksums[2]);
+
+        printf("%10d %9.2f ns %9.2f ns %9.2f ns %9.1fx\n",
+            counts[i],
+            perMob,
+            scalar,
+            simd,
+            perMob / simd);
+
+        // all of them should end with the mobs in the same place
+        if (fabs(checksums[0] - checksums[2]) > fabs(checksums[0]) * 1e-4
+            || checksums[1] != checksums[2]) {
+            printf("Checksums differ: %f %f %f\n", checksums[0], checksums[1], checksums[2]);
+            return 1;
+        }
+
+        freeMobs(&mobs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+// Headless runner: simulates a scene without a window, as fast as the CPU allows.
+// Built with `make headless`, run from the repo root:
+//   ./build/main_headless <sceneIndex> [towersScript] [maxSimulatedSeconds] [threads] [intercept]
+// Results must be the same for any number of threads.
+#include "../game/gameplay.h"
+#include "../game/scenes/scene_data.h"
+#include "../game/scenes/scene_timers.h"
+#include "../game/scenes/towers_manager.h"
+#include "../game/scenes/wave_manager.h"
+#include "../utils/jobs.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HEADLESS_DEFAULT_MAX_SECONDS 600
+
+static double getWallSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+/// Places the towers listed in the script. Returns how many were placed
+static int loadTowersScript(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror("No se pudo abrir el archivo");
+        return 0;
+    }
+
+    char line[256];
+    int lineNumber = 0;
+    int placedCount = 0;
+
+    while (fgets(line, sizeof(line), f)) {
+        lineNumber++;
+
+        line[strcspn(line, "\r\n")] = '\0';
+
+        if (line[0] == '#' || line[0] == '\0')
+            continue;
+
+        switch (line[0]) {
+        case 'T': { // Tower
+            int x, y, type;
+            int strategy = TARGET_STRATEGY_FIRST;
+            int scanResponse = sscanf(line, "T %d %d %d %d", &x, &y, &type, &strategy);
+
+            assert(scanResponse >= 3 && "Line failed to be parsed. Missing values?");
+            assert(type >= 0 && type < TOWER_TYPE_COUNT && "Invalid tower type");
+            assert(strategy >= 0 && strategy < TARGET_STRATEGY_COUNT && "Invalid target strategy");
+
+            if (towers_place(type, x, y)) {
+                towers_setTargetStrategy(x, y, strategy);
+                placedCount++;
+            } else {
+                printf("Tower not placed (%d): %s\n", lineNumber, line);
+            }
+        } break;
+
+        default:
+            printf("Unknown line (%d): %s\n", lineNumber, line);
+        }
+    }
+
+    fclose(f);
+
+    return placedCount;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        printf("Usage: %s <sceneIndex> [towersScript] [maxSimulatedSeconds] [threads] "
+               "[intercept]\n",
+            argv[0]);
+        return 1;
+    }
+
+    int sceneIndex = atoi(argv[1]);
+    float maxSeconds = argc > 3 ? atof(argv[3]) : HEADLESS_DEFAULT_MAX_SECONDS;
+    long maxTicks = maxSeconds * GAMEPLAY_TICKS_PER_SECOND;
+    // 0: one per core
+    int threadsCount = argc > 4 ? atoi(argv[4]) : 0;
+    gameplay_interceptBullets = argc > 5 && strcmp(argv[5], "intercept") == 0;
+
+    jobs_init(threadsCount);
+
+    scene_data_load(sceneIndex);
+    sceneTimers_clear();
+    towers_clear();
+    wave_initData();
+
+    int towersCount = argc > 2 ? loadTowersScript(argv[2]) : 0;
+
+    double start = getWallSeconds();
+    long ticks = 0;
+
+    while (ticks < maxTicks && !wave_isSceneCleared()) {
+        sceneTimers_advance();
+        wave_update(GAMEPLAY_TICK_SECONDS);
+        towers_update(GAMEPLAY_TICK_SECONDS);
+        ticks++;
+    }
+
+    double elapsed = getWallSeconds() - start;
+
+    printf("Scene %d %s: %s after %ld ticks (%.1f simulated seconds)\n",
+        sceneIndex,
+        SCENE_DATA->name,
+        wave_isSceneCleared() ? "cleared" : "timed out",
+        ticks,
+        ticks * GAMEPLAY_TICK_SECONDS);
+    printf("Towers: %d\n", towersCount);
+    printf("Mobs: %d killed, %d escaped, %d total\n",
+        wave_getKilledCount(),
+        wave_getEscapedCount(),
+        wave_getMobCount());
+    printf("Wall time: %.3fs, %.0f ticks/sec\n", elapsed, elapsed > 0 ? ticks / elapsed : 0);
+
+    jobs_shutdown();
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include "ui_text_run.h"
+#include <assert.h>
+#include <raylib.h>
+#include <rlgl.h>
+#include <string.h>
+
+// Enough for any int, sign included
+#define UI_TEXT_RUN_MAX_NUMBER_GLYPHS 11
+
+bool uiTextRun_set(UITextRun *run, Font font, float fontSize, float spacing, const char *text) {
+    if (run->font.texture.id == font.texture.id && run->fontSize == fontSize
+        && run->spacing == spacing && strcmp(run->text, text) == 0) {
+        return false;
+    }
+
+    size_t length = strlen(text);
+    assert(length <= UI_TEXT_RUN_MAX_GLYPHS && "Text too long for a text run");
+
+    memcpy(run->text, text, length + 1);
+    run->font = font;
+    run->fontSize = fontSize;
+    run->spacing = spacing;
+    run->glyphsCount = 0;
+
+    float scale = fontSize / font.baseSize;
+    float padding = font.glyphPadding;
+    float penX = 0;
+
+    for (size_t i = 0; i < length;) {
+        int codepointSize = 0;
+        int codepoint = GetCodepointNext(&text[i], &codepointSize);
+        i += codepointSize;
+
+        assert(codepoint != '\n' && "Text runs are a single line");
+
+        int index = GetGlyphIndex(font, codepoint);
+        Rectangle rec = font.recs[index];
+        GlyphInfo info = font.glyphs[index];
+
+        UIGlyphQuad *glyph = &run->glyphs[run->glyphsCount++];
+        glyph->penX = penX;
+        glyph->advance = (info.advanceX == 0 ? rec.width : info.advanceX) * scale + spacing;
+        // blanks take room but aren't drawn
+        glyph->dest = (Rectangle){0};
+
+        if (codepoint != ' ' && codepoint != '\t') {
+            glyph->dest = (Rectangle){
+                penX + (info.offsetX - padding) * scale,
+                (info.offsetY - padding) * scale,
+                (rec.width + 2 * padding) * scale,
+                (rec.height + 2 * padding) * scale,
+            };
+            glyph->u0 = (rec.x - padding) / font.texture.width;
+            glyph->v0 = (rec.y - padding) / font.texture.height;
+            glyph->u1 = (rec.x + rec.width + padding) / font.texture.width;
+            glyph->v1 = (rec.y + rec.height + padding) / font.texture.height;
+        }
+
+        penX += glyph->advance;
+    }
+
+    run->width = penX;
+
+    return true;
+}
+
+/// Room for `glyphsCount` quads of `font` in the current batch, and their state
+void beginGlyphs(Font font, int glyphsCount, Color color) {
+    rlCheckRenderBatchLimit(4 * glyphsCount);
+    rlSetTexture(font.texture.id);
+    rlBegin(RL_QUADS);
+
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    rlNormal3f(0, 0, 1);
+}
+
+void endGlyphs() {
+    rlEnd();
+    rlSetTexture(0);
+}
+
+/// `offsetX` moves it from where it was laid out
+void drawGlyph(const UIGlyphQuad *glyph, Vector2 position, float offsetX) {
+    if (glyph->dest.width == 0) {
+        return;
+    }
+
+    float left = position.x + offsetX + glyph->dest.x;
+    float top = position.y + glyph->dest.y;
+    float right = left + glyph->dest.width;
+    float bottom = top + glyph->dest.height;
+
+    rlTexCoord2f(glyph->u0, glyph->v0);
+    rlVertex2f(left, top);
+
+    rlTexCoord2f(glyph->u0, glyph->v1);
+    rlVertex2f(left, bottom);
+
+    rlTexCoord2f(glyph->u1, glyph->v1);
+    rlVertex2f(right, bottom);
+
+    rlTexCoord2f(glyph->u1, glyph->v0);
+    rlVertex2f(right, top);
+}
+
+void uiTextRun_draw(const UITextRun *run, Vector2 position, Color color) {
+    if (run->glyphsCount == 0) {
+        return;
+    }
+
+    beginGlyphs(run->font, run->glyphsCount, color);
+
+    for (int i = 0; i < run->glyphsCount; i++) {
+        drawGlyph(&run->glyphs[i], position, 0);
+    }
+
+    endGlyphs();
+}
+
+float uiTextRun_drawNumber(const UITextRun *digits, int value, Vector2 position, Color color) {
+    assert(digits->glyphsCount == sizeof(UI_TEXT_RUN_DIGITS) - 1
+           && "Number drawn with a run not set to UI_TEXT_RUN_DIGITS");
+
+    // indices into the digits run, least significant first
+    int glyphs[UI_TEXT_RUN_MAX_NUMBER_GLYPHS];
+    int glyphsCount = 0;
+    // unsigned, so the lowest int can be negated
+    unsigned magnitude = value < 0 ? -(unsigned)value : (unsigned)value;
+
+    do {
+        glyphs[glyphsCount++] = magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude > 0);
+
+    if (value < 0) {
+        glyphs[glyphsCount++] = 10;
+    }
+
+    beginGlyphs(digits->font, glyphsCount, color);
+
+    float penX = 0;
+
+    for (int i = glyphsCount - 1; i >= 0; i--) {
+        const UIGlyphQuad *glyph = &digits->glyphs[glyphs[i]];
+        drawGlyph(glyph, position, penX - glyph->penX);
+        penX += glyph->advance;
+    }
+
+    endGlyphs();
+
+    return penX;
+}
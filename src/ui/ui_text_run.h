@@ -0,0 +1,42 @@
+#pragma once
+
+#include <raylib.h>
+#include <stdbool.h>
+
+// Text laid out once into glyph quads and drawn from them until it changes, instead of looking
+// every glyph up again each frame as DrawTextEx does. Quads of the same font share its texture,
+// so runs drawn one after another, with nothing else in between, go in the same batch.
+// Single line, no allocations.
+
+#define UI_TEXT_RUN_MAX_GLYPHS 32
+// For uiTextRun_drawNumber
+#define UI_TEXT_RUN_DIGITS "0123456789-"
+
+typedef struct {
+    // from the origin of the run, in pixels
+    Rectangle dest;
+    // in the font texture, normalized
+    float u0, v0, u1, v1;
+    // where the pen was before it, and how much it moved it
+    float penX;
+    float advance;
+} UIGlyphQuad;
+
+typedef struct {
+    Font font;
+    float fontSize;
+    float spacing;
+    char text[UI_TEXT_RUN_MAX_GLYPHS + 1];
+    int glyphsCount;
+    UIGlyphQuad glyphs[UI_TEXT_RUN_MAX_GLYPHS];
+    // up to the end of the last glyph, spacing included
+    float width;
+} UITextRun;
+
+/// Lays the text out, unless it's the same text, font, size and spacing as the last time.
+/// Returns whether it did. Same metrics as DrawTextEx. Zero-initialized runs are empty
+bool uiTextRun_set(UITextRun *run, Font font, float fontSize, float spacing, const char *text);
+void uiTextRun_draw(const UITextRun *run, Vector2 position, Color color);
+/// `value` made of the glyphs of `digits`, a run set to UI_TEXT_RUN_DIGITS, without formatting
+/// it into a string or laying it out. Returns its width
+float uiTextRun_drawNumber(const UITextRun *digits, int value, Vector2 position, Color color);
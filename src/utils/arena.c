@@ -0,0 +1,63 @@
+#include "arena.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_DEFAULT_BLOCK_SIZE (1024 * 1024)
+#define ARENA_ALIGNMENT 16
+
+struct ArenaBlock {
+    ArenaBlock *previous;
+    size_t capacity;
+    size_t used;
+    // aligned so the first allocation is aligned too
+    _Alignas(ARENA_ALIGNMENT) unsigned char data[];
+};
+
+static ArenaBlock *pushBlock(Arena *arena, size_t minCapacity) {
+    size_t blockSize = arena->blockSize != 0 ? arena->blockSize : ARENA_DEFAULT_BLOCK_SIZE;
+    size_t capacity = minCapacity > blockSize ? minCapacity : blockSize;
+
+    ArenaBlock *block = malloc(sizeof(ArenaBlock) + capacity);
+    assert(block != NULL && "Out of memory for arena block");
+
+    block->previous = arena->currentBlock;
+    block->capacity = capacity;
+    block->used = 0;
+
+    arena->currentBlock = block;
+
+    return block;
+}
+
+void *arena_alloc(Arena *arena, size_t size) {
+    size_t alignedSize = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+
+    ArenaBlock *block = arena->currentBlock;
+
+    if (block == NULL || block->capacity - block->used < alignedSize) {
+        // the rest of the current block is wasted. Fine for the few big allocations we do
+        block = pushBlock(arena, alignedSize);
+    }
+
+    void *memory = block->data + block->used;
+    block->used += alignedSize;
+    arena->totalAllocated += alignedSize;
+
+    memset(memory, 0, size);
+
+    return memory;
+}
+
+void arena_release(Arena *arena) {
+    ArenaBlock *block = arena->currentBlock;
+
+    while (block != NULL) {
+        ArenaBlock *previous = block->previous;
+        free(block);
+        block = previous;
+    }
+
+    arena->currentBlock = NULL;
+    arena->totalAllocated = 0;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stddef.h>
+
+// Bump allocator for data that lives as long as something else (i.e. a scene). Memory is never
+// freed piece by piece: arena_release drops everything at once.
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct {
+    ArenaBlock *currentBlock;
+    size_t blockSize;
+    // for debugging
+    size_t totalAllocated;
+} Arena;
+
+/// Zeroed, 16 bytes aligned. Never returns NULL (asserts)
+void *arena_alloc(Arena *arena, size_t size);
+
+void arena_release(Arena *arena);
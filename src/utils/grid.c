@@ -2,6 +2,7 @@
 #include "../game/constants.h"
 #include "utils.h"
 #include <assert.h>
+#include <math.h>
 
 bool grid_isValidCoords(int gridCols, int gridRows, float x, float y) {
     if (x < 0 || y < 0 || x >= gridCols || y >= gridRows) {
@@ -103,3 +104,26 @@ Vector2 grid_getTileCenter(const Transform2D *transform, int x, int y) {
 
     return grid_getIsoRecCenter(tile);
 }
+
+// Tile space: x and y are tile coordinates, so (x + 0.5, y + 0.5) is the center of tile (x, y).
+// The simulation lives here, unaffected by zoom and pan. Only drawing goes through the transform.
+
+Vector2 grid_getTileSpaceCenter(int x, int y) {
+    return (Vector2){x + 0.5f, y + 0.5f};
+}
+
+Vector2 grid_tileSpaceToWorldPoint(const Transform2D *transform, Vector2 point) {
+    float sumX = +point.x + point.y;
+    float sumY = -point.x + point.y;
+
+    return (Vector2){
+        transform->translation.x + (sumX * TILE_WIDTH * transform->scale / 2.0f),
+        transform->translation.y + (sumY * TILE_HEIGHT * transform->scale / 2.0f),
+    };
+}
+
+/// A circle in tile space is an ellipse in world space, twice as wide as it is tall. Returns its
+/// horizontal radius
+float grid_tileSpaceToWorldRadius(const Transform2D *transform, float radius) {
+    return radius * TILE_WIDTH * transform->scale / M_SQRT2;
+}
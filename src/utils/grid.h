@@ -34,3 +34,9 @@ Vector2 grid_getTileOrigin(const Transform2D *transform, V2i coords);
 Vector2 grid_getIsoRecCenter(IsoRec isoRec);
 
 Vector2 grid_getTileCenter(const Transform2D *transform, int x, int y);
+
+Vector2 grid_getTileSpaceCenter(int x, int y);
+
+Vector2 grid_tileSpaceToWorldPoint(const Transform2D *transform, Vector2 point);
+
+float grid_tileSpaceToWorldRadius(const Transform2D *transform, float radius);
@@ -0,0 +1,242 @@
+#include "jobs.h"
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+typedef struct {
+    JobFunction function;
+    void *context;
+    int start;
+    int end;
+} Job;
+
+// Jobs are only pushed between parallelFor calls, while every deque is empty, so a deque is just
+// an array with the owner's end (bottom) and the thieves' end (top)
+typedef struct {
+    pthread_mutex_t lock;
+    Job *jobs;
+    int capacity;
+    int top;
+    int bottom;
+} JobDeque;
+
+// Worker 0 is the thread that called jobs_init
+int threadsCount = 1;
+pthread_t threads[JOBS_MAX_WORKERS];
+JobDeque deques[JOBS_MAX_WORKERS];
+
+// Workers sleep until the generation changes
+pthread_mutex_t wakeLock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t wakeCondition = PTHREAD_COND_INITIALIZER;
+int wakeGeneration = 0;
+bool shuttingDown = false;
+
+// Jobs of the current parallelFor not finished yet
+atomic_int pendingJobs = 0;
+
+_Thread_local int currentWorkerIndex = 0;
+
+static bool popJob(int workerIndex, Job *job) {
+    JobDeque *deque = &deques[workerIndex];
+    bool found = false;
+
+    pthread_mutex_lock(&deque->lock);
+
+    if (deque->bottom > deque->top) {
+        *job = deque->jobs[--deque->bottom];
+        found = true;
+    }
+
+    pthread_mutex_unlock(&deque->lock);
+
+    return found;
+}
+
+static bool stealJob(int workerIndex, Job *job) {
+    for (int i = 1; i < threadsCount; i++) {
+        JobDeque *deque = &deques[(workerIndex + i) % threadsCount];
+        bool found = false;
+
+        pthread_mutex_lock(&deque->lock);
+
+        if (deque->bottom > deque->top) {
+            *job = deque->jobs[deque->top++];
+            found = true;
+        }
+
+        pthread_mutex_unlock(&deque->lock);
+
+        if (found) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// Runs jobs until there are none left to take. Others may still be running
+static void runAvailableJobs(int workerIndex) {
+    Job job;
+
+    while (popJob(workerIndex, &job) || stealJob(workerIndex, &job)) {
+        job.function(job.context, job.start, job.end);
+        atomic_fetch_sub(&pendingJobs, 1);
+    }
+}
+
+static void *workerMain(void *arg) {
+    int workerIndex = (int)(long)arg;
+    int seenGeneration = 0;
+
+    currentWorkerIndex = workerIndex;
+
+    while (true) {
+        pthread_mutex_lock(&wakeLock);
+
+        while (wakeGeneration == seenGeneration && !shuttingDown) {
+            pthread_cond_wait(&wakeCondition, &wakeLock);
+        }
+
+        seenGeneration = wakeGeneration;
+        bool exit = shuttingDown;
+
+        pthread_mutex_unlock(&wakeLock);
+
+        if (exit) {
+            return NULL;
+        }
+
+        runAvailableJobs(workerIndex);
+    }
+}
+
+void jobs_init(int requestedThreadsCount) {
+    if (requestedThreadsCount <= 0) {
+        requestedThreadsCount = sysconf(_SC_NPROCESSORS_ONLN);
+    }
+
+    threadsCount = requestedThreadsCount;
+
+    if (threadsCount < 1) {
+        threadsCount = 1;
+    }
+
+    if (threadsCount > JOBS_MAX_WORKERS) {
+        threadsCount = JOBS_MAX_WORKERS;
+    }
+
+    shuttingDown = false;
+
+    for (int i = 0; i < threadsCount; i++) {
+        pthread_mutex_init(&deques[i].lock, NULL);
+        deques[i].jobs = NULL;
+        deques[i].capacity = 0;
+        deques[i].top = 0;
+        deques[i].bottom = 0;
+    }
+
+    for (int i = 1; i < threadsCount; i++) {
+        int error = pthread_create(&threads[i], NULL, workerMain, (void *)(long)i);
+        assert(error == 0 && "Failed to create job worker thread");
+    }
+
+    printf("Job system running on %d threads\n", threadsCount);
+}
+
+void jobs_shutdown() {
+    pthread_mutex_lock(&wakeLock);
+    shuttingDown = true;
+    pthread_cond_broadcast(&wakeCondition);
+    pthread_mutex_unlock(&wakeLock);
+
+    for (int i = 1; i < threadsCount; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (int i = 0; i < threadsCount; i++) {
+        pthread_mutex_destroy(&deques[i].lock);
+        free(deques[i].jobs);
+    }
+
+    threadsCount = 1;
+}
+
+void jobs_parallelFor(int count, int chunkSize, JobFunction function, void *context) {
+    assert(chunkSize > 0 && "Invalid chunk size");
+
+    int chunksCount = (count + chunkSize - 1) / chunkSize;
+
+    // not worth waking anyone
+    if (threadsCount == 1 || chunksCount <= 1) {
+        for (int start = 0; start < count; start += chunkSize) {
+            function(context, start, start + chunkSize < count ? start + chunkSize : count);
+        }
+
+        return;
+    }
+
+    assert(atomic_load(&pendingJobs) == 0 && "jobs_parallelFor called from inside a job");
+
+    // before pushing: a worker still looking for work from the last call may take them already
+    atomic_store(&pendingJobs, chunksCount);
+
+    // contiguous runs of chunks per worker, so neighbours usually stay on the same thread
+    int chunksPerWorker = (chunksCount + threadsCount - 1) / threadsCount;
+
+    for (int w = 0; w < threadsCount; w++) {
+        JobDeque *deque = &deques[w];
+
+        pthread_mutex_lock(&deque->lock);
+
+        if (deque->capacity < chunksPerWorker) {
+            deque->jobs = realloc(deque->jobs, sizeof(Job) * chunksPerWorker);
+            assert(deque->jobs != NULL && "Out of memory for jobs");
+            deque->capacity = chunksPerWorker;
+        }
+
+        deque->top = 0;
+        deque->bottom = 0;
+
+        // pushed last to first, so the owner (popping from the bottom) goes first to last
+        int firstChunk = w * chunksPerWorker;
+        int lastChunk = firstChunk + chunksPerWorker;
+
+        if (lastChunk > chunksCount) {
+            lastChunk = chunksCount;
+        }
+
+        for (int c = lastChunk - 1; c >= firstChunk; c--) {
+            int start = c * chunkSize;
+            int end = start + chunkSize < count ? start + chunkSize : count;
+
+            deque->jobs[deque->bottom++] = (Job){function, context, start, end};
+        }
+
+        pthread_mutex_unlock(&deque->lock);
+    }
+
+    pthread_mutex_lock(&wakeLock);
+    wakeGeneration++;
+    pthread_cond_broadcast(&wakeCondition);
+    pthread_mutex_unlock(&wakeLock);
+
+    runAvailableJobs(0);
+
+    // the last ones may still be running somewhere else
+    while (atomic_load(&pendingJobs) > 0) {
+        sched_yield();
+    }
+}
+
+int jobs_getThreadsCount() {
+    return threadsCount;
+}
+
+int jobs_getWorkerIndex() {
+    return currentWorkerIndex;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+// Tiny job system for data parallel loops. jobs_parallelFor splits a range in chunks and spreads
+// them over the deques of the workers (the calling thread is one of them). Each worker takes from
+// the back of its own deque and, once empty, steals from the front of the others.
+//
+// Chunks run in any order and on any thread, so they must only write their own part of the
+// range. Done that way, results don't depend on the number of workers.
+
+#define JOBS_MAX_WORKERS 16
+
+/// Work on [start, end) of the range
+typedef void (*JobFunction)(void *context, int start, int end);
+
+/// `threadsCount` includes the calling thread. 0 to use one per core (up to JOBS_MAX_WORKERS),
+/// 1 to run everything on the calling thread
+void jobs_init(int threadsCount);
+void jobs_shutdown();
+
+/// Calls `function` over [0, count) in chunks of `chunkSize` and returns when all are done.
+/// Only from the thread that called jobs_init, and not from inside a job
+void jobs_parallelFor(int count, int chunkSize, JobFunction function, void *context);
+
+int jobs_getThreadsCount();
+/// 0 .. jobs_getThreadsCount() - 1. 0 for the thread that called jobs_init. For per-thread data
+int jobs_getWorkerIndex();